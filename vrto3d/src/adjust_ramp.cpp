@@ -0,0 +1,67 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "adjust_ramp.h"
+
+#include <algorithm>
+
+
+// A fresh press acts as if it had been held for one 60Hz frame, so a tap
+// shorter than a tick still moves the value
+static constexpr std::chrono::microseconds k_first_step( 16667 );
+
+// Longest gap integrated in one step, a stalled thread shouldn't jump the value
+static constexpr std::chrono::milliseconds k_max_step( 100 );
+
+
+AdjustRamp::AdjustRamp()
+    : direction_( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Delta to apply this tick for direction -1, 0 or +1
+//-----------------------------------------------------------------------------
+float AdjustRamp::Step( int direction, Clock::time_point now, float rate, float accel )
+{
+    if ( direction == 0 )
+    {
+        direction_ = 0;
+        return 0.0f;
+    }
+
+    if ( direction != direction_ )
+    {
+        direction_ = direction;
+        start_ = now - k_first_step;
+        last_ = start_;
+    }
+
+    auto from = std::max( last_, now - k_max_step );
+    last_ = now;
+
+    // Integral of rate * (1 + accel * t) dt over the step, with the speedup capped
+    float t0 = std::chrono::duration< float >( from - start_ ).count();
+    float t1 = std::chrono::duration< float >( now - start_ ).count();
+    float t_cap = accel > 0.0f ? ( k_max_speedup - 1.0f ) / accel : t1;
+    auto integral = [ & ]( float t ) {
+        float ramp = std::min( t, t_cap );
+        return ramp + 0.5f * accel * ramp * ramp + std::max( t - t_cap, 0.0f ) * ( 1.0f + accel * t_cap );
+    };
+
+    return direction * rate * ( integral( t1 ) - integral( t0 ) );
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Integrates a held +/- adjustment against real elapsed time. The
+// rate starts at rate units per second and grows linearly by accel times the
+// rate for every second the key stays held, up to k_max_speedup times the
+// base rate, so a tap nudges the value and a long hold sweeps the range.
+//-----------------------------------------------------------------------------
+class AdjustRamp
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr float k_max_speedup = 10.0f;
+
+    AdjustRamp();
+
+    float Step( int direction, Clock::time_point now, float rate, float accel );
+    void Reset() { direction_ = 0; }
+
+private:
+    int direction_;
+    Clock::time_point start_;
+    Clock::time_point last_;
+};
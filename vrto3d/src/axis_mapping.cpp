@@ -0,0 +1,112 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "axis_mapping.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+// Longest gap integrated in one step, a stalled thread shouldn't jump the value
+static constexpr std::chrono::milliseconds k_max_step( 100 );
+
+
+AxisMapper::AxisMapper()
+    : active_( false ), accum_( 0.0f ), last_value_( 0.0f )
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Normalized axis position, -1..1 for sticks and the trigger pair,
+// 0..1 for a single trigger
+//-----------------------------------------------------------------------------
+float AxisMapper::ReadAxis( int axis, const GamepadState &pad )
+{
+    switch ( axis )
+    {
+    case AXIS_TRIGGERS:
+        return ( pad.right_trigger - pad.left_trigger ) / 255.0f;
+    case AXIS_LEFT_TRIGGER:
+        return pad.left_trigger / 255.0f;
+    case AXIS_RIGHT_TRIGGER:
+        return pad.right_trigger / 255.0f;
+    case AXIS_LEFT_STICK_X:
+        return std::max( pad.thumb_lx / 32767.0f, -1.0f );
+    case AXIS_LEFT_STICK_Y:
+        return std::max( pad.thumb_ly / 32767.0f, -1.0f );
+    case AXIS_RIGHT_STICK_X:
+        return std::max( pad.thumb_rx / 32767.0f, -1.0f );
+    case AXIS_RIGHT_STICK_Y:
+        return std::max( pad.thumb_ry / 32767.0f, -1.0f );
+    default:
+        return 0.0f;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: True if the controller pushes the axis past its deadzone
+//-----------------------------------------------------------------------------
+bool AxisMapper::IsDeflected( const AxisMapping &mapping, const InputSample &input )
+{
+    if ( !input.connected || mapping.deadzone >= 1.0f )
+        return false;
+    return std::abs( ReadAxis( mapping.axis, input.pad ) ) > mapping.deadzone;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Advance by the time since the last update. current is the value
+// as it is now, returns true with the new value when the quantized output
+// has moved.
+//-----------------------------------------------------------------------------
+bool AxisMapper::Update( const AxisMapping &mapping, const InputSample &input, Clock::time_point now, float current, float &value )
+{
+    if ( !IsDeflected( mapping, input ) )
+    {
+        active_ = false;
+        return false;
+    }
+
+    // Rescale the travel past the deadzone and apply the curve
+    float x = ReadAxis( mapping.axis, input.pad );
+    float magnitude = std::abs( x );
+    magnitude = ( magnitude - mapping.deadzone ) / ( 1.0f - mapping.deadzone );
+    float shaped = std::copysign( std::pow( magnitude, std::max( mapping.curve, 0.1f ) ), x );
+
+    // Start from the live value, and follow it if something else changed it
+    if ( !active_ || current != last_value_ )
+    {
+        active_ = true;
+        accum_ = current;
+        last_value_ = current;
+        last_ = now;
+        return false;
+    }
+
+    float dt = std::chrono::duration< float >( std::min< Clock::duration >( now - last_, k_max_step ) ).count();
+    last_ = now;
+    accum_ += shaped * mapping.rate * dt;
+
+    float quantized = mapping.step > 0.0f ? std::round( accum_ / mapping.step ) * mapping.step : accum_;
+    if ( quantized == last_value_ )
+        return false;
+
+    last_value_ = quantized;
+    value = quantized;
+    return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include "input_bus.h"
+
+// Controller axes that can drive Depth or Convergence
+#define AXIS_NONE          0
+#define AXIS_TRIGGERS      1
+#define AXIS_LEFT_TRIGGER  2
+#define AXIS_RIGHT_TRIGGER 3
+#define AXIS_LEFT_STICK_X  4
+#define AXIS_LEFT_STICK_Y  5
+#define AXIS_RIGHT_STICK_X 6
+#define AXIS_RIGHT_STICK_Y 7
+static std::unordered_map<std::string, int> AxisMappings = {
+    {"none", AXIS_NONE},
+    {"triggers", AXIS_TRIGGERS},
+    {"left_trigger", AXIS_LEFT_TRIGGER},
+    {"right_trigger", AXIS_RIGHT_TRIGGER},
+    {"left_stick_x", AXIS_LEFT_STICK_X},
+    {"left_stick_y", AXIS_LEFT_STICK_Y},
+    {"right_stick_x", AXIS_RIGHT_STICK_X},
+    {"right_stick_y", AXIS_RIGHT_STICK_Y}
+};
+
+
+// How an axis moves its value
+struct AxisMapping
+{
+    int axis;        // AXIS_*
+    float deadzone;  // fraction of travel ignored around rest
+    float curve;     // response exponent, 1 is linear
+    float rate;      // units per second at full deflection
+    float step;      // output is quantized to multiples of this
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Maps a controller axis to a rate of change of one value. The
+// deflection is shaped by the deadzone and curve and integrated over real
+// time; the result is quantized to step and only reported when the quantized
+// value changes, so a slowly moving axis doesn't emit an update every tick.
+//-----------------------------------------------------------------------------
+class AxisMapper
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AxisMapper();
+
+    bool Update( const AxisMapping &mapping, const InputSample &input, Clock::time_point now, float current, float &value );
+    void Reset() { active_ = false; }
+
+    static float ReadAxis( int axis, const GamepadState &pad );
+    static bool IsDeflected( const AxisMapping &mapping, const InputSample &input );
+
+private:
+    bool active_;
+    float accum_;
+    float last_value_;
+    Clock::time_point last_;
+};
@@ -0,0 +1,75 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "binding_state.h"
+
+
+BindingState::BindingState( Clock::duration debounce, Clock::duration repeat_delay, Clock::duration repeat_interval )
+    : debounce_( debounce ), repeat_delay_( repeat_delay ), repeat_interval_( repeat_interval )
+{
+    Reset();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Forget any press in progress and the debounce history
+//-----------------------------------------------------------------------------
+void BindingState::Reset()
+{
+    pressed_ = false;
+    has_pressed_ = false;
+    last_press_ = Clock::time_point();
+    next_repeat_ = Clock::time_point();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Feed the current level of the bind, returns the BIND_* events
+//-----------------------------------------------------------------------------
+uint32_t BindingState::Update( bool down, Clock::time_point now )
+{
+    if ( !down )
+    {
+        if ( !pressed_ )
+            return 0;
+        pressed_ = false;
+        return BIND_RELEASE;
+    }
+
+    if ( !pressed_ )
+    {
+        // Still inside the window of the previous press, try again next update
+        if ( has_pressed_ && now - last_press_ < debounce_ )
+            return 0;
+
+        pressed_ = true;
+        has_pressed_ = true;
+        last_press_ = now;
+        next_repeat_ = now + repeat_delay_;
+        return BIND_PRESS;
+    }
+
+    if ( repeat_interval_ > Clock::duration::zero() && now >= next_repeat_ )
+    {
+        // Catch up from the schedule, not from now, so repeats don't drift
+        next_repeat_ += repeat_interval_;
+        if ( next_repeat_ <= now )
+            next_repeat_ = now + repeat_interval_;
+        return BIND_REPEAT;
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+
+// Events a bind can raise in one update, OR'd together
+#define BIND_PRESS   0x1
+#define BIND_RELEASE 0x2
+#define BIND_REPEAT  0x4
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns a bind's held/not-held level into press, release and repeat
+// events using monotonic timestamps, so behaviour doesn't depend on how often
+// it is updated. A press is only accepted once debounce has passed since the
+// previous accepted press; one arriving earlier is delayed, not dropped, if
+// the bind is still held when the window ends. While held, repeats fire after
+// repeat_delay and then every repeat_interval, a zero repeat_interval turns
+// auto-repeat off. The caller passes the time in, so any clock can drive it.
+//-----------------------------------------------------------------------------
+class BindingState
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    BindingState( Clock::duration debounce = Clock::duration::zero(),
+        Clock::duration repeat_delay = Clock::duration::zero(),
+        Clock::duration repeat_interval = Clock::duration::zero() );
+
+    uint32_t Update( bool down, Clock::time_point now );
+    void Reset();
+
+    bool IsPressed() const { return pressed_; }
+
+private:
+    Clock::duration debounce_;
+    Clock::duration repeat_delay_;
+    Clock::duration repeat_interval_;
+
+    bool pressed_;
+    bool has_pressed_;
+    Clock::time_point last_press_;
+    Clock::time_point next_repeat_;
+};
@@ -0,0 +1,657 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_fields.h"
+#include "json_manager.h"
+#include "driverlog.h"
+#include "key_mappings.h"
+#include "pose_prediction.h"
+#include "axis_mapping.h"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+
+
+// Where a config field lives: default_config.json only, every profile, or
+// each entry of a profile's user_settings array
+enum ConfigFieldScope
+{
+    SCOPE_PARAMS,
+    SCOPE_PROFILE,
+    SCOPE_USER
+};
+
+enum ConfigFieldType
+{
+    FIELD_INT,
+    FIELD_FLOAT,
+    FIELD_BOOL,
+    FIELD_STRING,
+    FIELD_ENUM // Name in the string member, its value in the int member
+};
+
+using Config = StereoDisplayDriverConfiguration;
+using NameMap = std::unordered_map<std::string, int>;
+
+static constexpr double k_no_min = std::numeric_limits<double>::lowest();
+static constexpr double k_no_max = std::numeric_limits<double>::max();
+static constexpr double k_int_min = std::numeric_limits<int32_t>::min();
+static constexpr double k_int_max = std::numeric_limits<int32_t>::max();
+static constexpr double k_max_resolution = 16384.0;
+
+//-----------------------------------------------------------------------------
+// Purpose: Describes one config field for loading, defaulting, range checking
+// and saving. SCOPE_USER fields point at the per-entry vectors instead.
+//-----------------------------------------------------------------------------
+struct ConfigField
+{
+    const char* key;
+    ConfigFieldScope scope;
+    ConfigFieldType type;
+
+    int32_t Config::* int_member;
+    float Config::* float_member;
+    bool Config::* bool_member;
+    std::string Config::* string_member;
+    std::vector<int32_t> Config::* int_list;
+    std::vector<float> Config::* float_list;
+    std::vector<std::string> Config::* string_list;
+
+    const NameMap* names; // FIELD_ENUM choices
+    double def;
+    const char* def_str;
+    int32_t unknown;      // FIELD_ENUM value for names not in choices
+    double min;
+    double max;
+};
+
+// Int ranges are kept within int32_t so a clamped value always converts
+static constexpr ConfigField IntField(const char* key, ConfigFieldScope scope, int32_t Config::* member, int32_t def, double min = k_int_min, double max = k_int_max)
+{
+    return { key, scope, FIELD_INT, member, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, (double)def, nullptr, 0, min, max };
+}
+
+static constexpr ConfigField FloatField(const char* key, ConfigFieldScope scope, float Config::* member, double def, double min = k_no_min, double max = k_no_max)
+{
+    return { key, scope, FIELD_FLOAT, nullptr, member, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, def, nullptr, 0, min, max };
+}
+
+static constexpr ConfigField BoolField(const char* key, ConfigFieldScope scope, bool Config::* member, bool def)
+{
+    return { key, scope, FIELD_BOOL, nullptr, nullptr, member, nullptr, nullptr, nullptr, nullptr, nullptr, def ? 1.0 : 0.0, nullptr, 0, 0.0, 1.0 };
+}
+
+static constexpr ConfigField StringField(const char* key, ConfigFieldScope scope, std::string Config::* member, const char* def)
+{
+    return { key, scope, FIELD_STRING, nullptr, nullptr, nullptr, member, nullptr, nullptr, nullptr, nullptr, 0.0, def, 0, 0.0, 0.0 };
+}
+
+static constexpr ConfigField EnumField(const char* key, ConfigFieldScope scope, int32_t Config::* member, std::string Config::* name, const NameMap* names, const char* def, int32_t unknown)
+{
+    return { key, scope, FIELD_ENUM, member, nullptr, nullptr, name, nullptr, nullptr, nullptr, names, 0.0, def, unknown, 0.0, 0.0 };
+}
+
+static constexpr ConfigField FloatListField(const char* key, std::vector<float> Config::* member, double def, double min = k_no_min, double max = k_no_max)
+{
+    return { key, SCOPE_USER, FIELD_FLOAT, nullptr, nullptr, nullptr, nullptr, nullptr, member, nullptr, nullptr, def, nullptr, 0, min, max };
+}
+
+static constexpr ConfigField StringListField(const char* key, std::vector<std::string> Config::* member, const char* def)
+{
+    return { key, SCOPE_USER, FIELD_STRING, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, member, nullptr, 0.0, def, 0, 0.0, 0.0 };
+}
+
+static constexpr ConfigField EnumListField(const char* key, std::vector<int32_t> Config::* member, std::vector<std::string> Config::* name, const NameMap* names, const char* def, int32_t unknown)
+{
+    return { key, SCOPE_USER, FIELD_ENUM, nullptr, nullptr, nullptr, nullptr, member, nullptr, name, names, 0.0, def, unknown, 0.0, 0.0 };
+}
+
+// Every config field, in the order they are written to default_config.json
+static constexpr ConfigField config_fields[] = {
+    IntField("window_width", SCOPE_PARAMS, &Config::window_width, 1920, 1, k_max_resolution),
+    IntField("window_height", SCOPE_PARAMS, &Config::window_height, 1080, 1, k_max_resolution),
+    IntField("render_width", SCOPE_PARAMS, &Config::render_width, 1920, 1, k_max_resolution),
+    IntField("render_height", SCOPE_PARAMS, &Config::render_height, 1080, 1, k_max_resolution),
+    FloatField("hmd_height", SCOPE_PROFILE, &Config::hmd_height, 1.0),
+    FloatField("aspect_ratio", SCOPE_PARAMS, &Config::aspect_ratio, 1.77778, 0.1, 10.0),
+    FloatField("fov", SCOPE_PARAMS, &Config::fov, 90.0, 1.0, 179.0),
+    FloatField("depth", SCOPE_PROFILE, &Config::depth, 0.5, 0.0),
+    FloatField("convergence", SCOPE_PROFILE, &Config::convergence, 0.02),
+    BoolField("disable_hotkeys", SCOPE_PARAMS, &Config::disable_hotkeys, false),
+    BoolField("tab_enable", SCOPE_PARAMS, &Config::tab_enable, false),
+    BoolField("reverse_enable", SCOPE_PARAMS, &Config::reverse_enable, false),
+    BoolField("depth_gauge", SCOPE_PARAMS, &Config::depth_gauge, false),
+    BoolField("debug_enable", SCOPE_PARAMS, &Config::debug_enable, true),
+    FloatField("display_latency", SCOPE_PARAMS, &Config::display_latency, 0.011, 0.0, 1.0),
+    FloatField("display_frequency", SCOPE_PARAMS, &Config::display_frequency, 60.0, 1.0, 1000.0),
+    EnumField("pose_prediction", SCOPE_PARAMS, &Config::pose_prediction, &Config::pose_prediction_str, &PredictionModels, "none", PREDICT_NONE),
+    FloatField("prediction_damping", SCOPE_PARAMS, &Config::prediction_damping, 0.05, 0.0),
+    FloatField("pose_keepalive_rate", SCOPE_PARAMS, &Config::pose_keepalive_rate, 10.0, 0.0),
+    FloatField("adjust_rate", SCOPE_PARAMS, &Config::adjust_rate, 0.06, 0.0),
+    FloatField("adjust_accel", SCOPE_PARAMS, &Config::adjust_accel, 1.0, 0.0),
+    BoolField("notify_tone", SCOPE_PARAMS, &Config::notify_tone, true),
+    BoolField("notify_rumble", SCOPE_PARAMS, &Config::notify_rumble, false),
+    EnumField("depth_axis", SCOPE_PARAMS, &Config::depth_axis, &Config::depth_axis_str, &AxisMappings, "none", AXIS_NONE),
+    EnumField("convergence_axis", SCOPE_PARAMS, &Config::convergence_axis, &Config::convergence_axis_str, &AxisMappings, "none", AXIS_NONE),
+    FloatField("axis_rate", SCOPE_PARAMS, &Config::axis_rate, 0.3, 0.0),
+    FloatField("axis_curve", SCOPE_PARAMS, &Config::axis_curve, 2.0, 0.1, 10.0),
+    FloatField("axis_step", SCOPE_PARAMS, &Config::axis_step, 0.001, 0.0),
+    BoolField("pitch_enable", SCOPE_PROFILE, &Config::pitch_enable, false),
+    BoolField("yaw_enable", SCOPE_PROFILE, &Config::yaw_enable, false),
+    StringField("pose_reset_key", SCOPE_PROFILE, &Config::pose_reset_str, "VK_NUMPAD7"),
+    StringField("ctrl_toggle_key", SCOPE_PROFILE, &Config::ctrl_toggle_str, "XINPUT_GAMEPAD_RIGHT_THUMB"),
+    EnumField("ctrl_toggle_type", SCOPE_PROFILE, &Config::ctrl_type, &Config::ctrl_type_str, &KeyBindTypes, "toggle", TOGGLE),
+    FloatField("pitch_radius", SCOPE_PROFILE, &Config::pitch_radius, 0.0),
+    FloatField("ctrl_deadzone", SCOPE_PROFILE, &Config::ctrl_deadzone, 0.05, 0.0, 1.0),
+    FloatField("ctrl_sensitivity", SCOPE_PROFILE, &Config::ctrl_sensitivity, 1.0, 0.0),
+
+    StringListField("user_load_key", &Config::user_load_str, ""),
+    StringListField("user_store_key", &Config::user_store_str, ""),
+    EnumListField("user_key_type", &Config::user_key_type, &Config::user_type_str, &KeyBindTypes, "switch", SWITCH),
+    FloatListField("user_depth", &Config::user_depth, 0.5, 0.0),
+    FloatListField("user_convergence", &Config::user_convergence, 0.02),
+};
+static constexpr size_t k_num_config_fields = sizeof(config_fields) / sizeof(config_fields[0]);
+
+
+template <typename T>
+static T& FieldRef(Config& config, T Config::* member, std::vector<T> Config::* list, size_t index)
+{
+    return member ? config.*member : (config.*list)[index];
+}
+
+template <typename T>
+static const T& FieldRef(const Config& config, T Config::* member, std::vector<T> Config::* list, size_t index)
+{
+    return member ? config.*member : (config.*list)[index];
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Field for a JSON key, or nullptr if there is none
+//-----------------------------------------------------------------------------
+static const ConfigField* FindField(const std::string& key)
+{
+    static const std::unordered_map<std::string, const ConfigField*> index = [] {
+        std::unordered_map<std::string, const ConfigField*> fields;
+        for (const auto& field : config_fields) {
+            fields.emplace(field.key, &field);
+        }
+        return fields;
+    }();
+
+    auto found = index.find(key);
+    return found != index.end() ? found->second : nullptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Set a field to its default
+//-----------------------------------------------------------------------------
+static void ResetField(const ConfigField& field, Config& config, size_t index)
+{
+    switch (field.type) {
+    case FIELD_INT:
+        FieldRef(config, field.int_member, field.int_list, index) = (int32_t)field.def;
+        break;
+    case FIELD_FLOAT:
+        FieldRef(config, field.float_member, field.float_list, index) = (float)field.def;
+        break;
+    case FIELD_BOOL:
+        config.*field.bool_member = field.def != 0.0;
+        break;
+    case FIELD_STRING:
+        FieldRef(config, field.string_member, field.string_list, index) = field.def_str;
+        break;
+    case FIELD_ENUM: {
+        auto found = field.names->find(field.def_str);
+        FieldRef(config, field.string_member, field.string_list, index) = field.def_str;
+        FieldRef(config, field.int_member, field.int_list, index) = found != field.names->end() ? found->second : field.unknown;
+        break;
+    }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Copy a field from another config, for entries past the end of
+// its user settings the built-in default is used
+//-----------------------------------------------------------------------------
+static void CopyField(const ConfigField& field, const Config& from, Config& config, size_t index)
+{
+    if (field.scope == SCOPE_USER && index >= from.num_user_settings) {
+        ResetField(field, config, index);
+        return;
+    }
+
+    switch (field.type) {
+    case FIELD_INT:
+        FieldRef(config, field.int_member, field.int_list, index) = FieldRef(from, field.int_member, field.int_list, index);
+        break;
+    case FIELD_FLOAT:
+        FieldRef(config, field.float_member, field.float_list, index) = FieldRef(from, field.float_member, field.float_list, index);
+        break;
+    case FIELD_BOOL:
+        config.*field.bool_member = from.*field.bool_member;
+        break;
+    case FIELD_STRING:
+        FieldRef(config, field.string_member, field.string_list, index) = FieldRef(from, field.string_member, field.string_list, index);
+        break;
+    case FIELD_ENUM:
+        FieldRef(config, field.string_member, field.string_list, index) = FieldRef(from, field.string_member, field.string_list, index);
+        FieldRef(config, field.int_member, field.int_list, index) = FieldRef(from, field.int_member, field.int_list, index);
+        break;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Compiled profile layout: a SidecarHeader, then record_count records of one
+// SidecarValue per config_fields entry, then the string table. Record 0 holds
+// the top level fields, every further record one user_settings entry. All of
+// it is fixed size and in config_fields order, so loading a compiled profile
+// is a bounds check and a copy into the config, no parsing.
+//-----------------------------------------------------------------------------
+struct SidecarHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t json_size;       // Size of the JSON it was compiled from
+    uint64_t json_write_time; // FILETIME of the JSON it was compiled from
+    uint32_t layout;          // LayoutHash() of the build that compiled it
+    uint32_t record_count;
+    uint32_t flags;
+    uint32_t string_size;
+};
+
+enum SidecarValueKind : uint32_t
+{
+    VALUE_MISSING,
+    VALUE_NUMBER,
+    VALUE_BOOL,
+    VALUE_STRING,
+    VALUE_OTHER // Present, but no field takes it
+};
+
+struct SidecarValue
+{
+    uint32_t kind;
+    uint32_t length; // VALUE_STRING bytes
+    uint64_t offset; // VALUE_STRING start in the string table
+    double number;   // VALUE_NUMBER, or VALUE_BOOL as 0 or 1
+};
+
+static constexpr uint32_t k_sidecar_magic = 0x50443356; // "V3DP"
+// Bump whenever the structs above change, older sidecars get rebuilt
+static constexpr uint32_t k_sidecar_version = 2;
+static constexpr uint32_t k_sidecar_user_settings = 0x1; // The JSON had a user_settings array
+static constexpr size_t k_no_record = std::numeric_limits<size_t>::max();
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Hash of the field table, a sidecar compiled against a different
+// table is rebuilt instead of being read into the wrong fields
+//-----------------------------------------------------------------------------
+static uint32_t LayoutHash()
+{
+    static const uint32_t layout = [] {
+        uint32_t hash = 2166136261u; // FNV-1a
+        auto mix = [&](uint32_t byte) { hash = (hash ^ byte) * 16777619u; };
+        for (const auto& field : config_fields) {
+            for (const char* c = field.key; *c; ++c) {
+                mix((uint8_t)*c);
+            }
+            mix(field.scope);
+            mix(field.type);
+        }
+        return hash;
+    }();
+    return layout;
+}
+
+
+static SidecarHeader HeaderOf(const CompiledProfile& profile)
+{
+    SidecarHeader header = {};
+    if (profile.size() >= sizeof(header)) {
+        memcpy(&header, profile.data(), sizeof(header));
+    }
+    return header;
+}
+
+static size_t StringsAt(uint32_t record_count)
+{
+    return sizeof(SidecarHeader) + (size_t)record_count * k_num_config_fields * sizeof(SidecarValue);
+}
+
+static SidecarValue ValueAt(const CompiledProfile& profile, uint32_t record_count, size_t record, size_t field)
+{
+    SidecarValue value = {};
+    if (record < record_count) {
+        memcpy(&value, profile.data() + sizeof(SidecarHeader) + (record * k_num_config_fields + field) * sizeof(value), sizeof(value));
+    }
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Set a field from a compiled value. Values of the wrong type are
+// left to the caller to default, out of range numbers are clamped.
+//-----------------------------------------------------------------------------
+static bool ReadField(const ConfigField& field, const SidecarValue& value, const char* strings, Config& config, size_t index, const std::string& source)
+{
+    switch (field.type) {
+    case FIELD_INT:
+    case FIELD_FLOAT: {
+        if (value.kind != VALUE_NUMBER) {
+            break;
+        }
+        double clamped = std::clamp(value.number, field.min, field.max);
+        if (clamped != value.number) {
+            DriverLog("%s: %s %g out of range, using %g\n", source.c_str(), field.key, value.number, clamped);
+        }
+        if (field.type == FIELD_INT) {
+            FieldRef(config, field.int_member, field.int_list, index) = (int32_t)clamped;
+        }
+        else {
+            FieldRef(config, field.float_member, field.float_list, index) = (float)clamped;
+        }
+        return true;
+    }
+    case FIELD_BOOL:
+        if (value.kind != VALUE_BOOL) {
+            break;
+        }
+        config.*field.bool_member = value.number != 0.0;
+        return true;
+    case FIELD_STRING:
+        if (value.kind != VALUE_STRING) {
+            break;
+        }
+        FieldRef(config, field.string_member, field.string_list, index).assign(strings + value.offset, value.length);
+        return true;
+    case FIELD_ENUM: {
+        if (value.kind != VALUE_STRING) {
+            break;
+        }
+        std::string& name = FieldRef(config, field.string_member, field.string_list, index);
+        name.assign(strings + value.offset, value.length);
+        auto found = field.names->find(name);
+        if (found == field.names->end()) {
+            DriverLog("%s: unknown %s %s\n", source.c_str(), field.key, name.c_str());
+        }
+        FieldRef(config, field.int_member, field.int_list, index) = found != field.names->end() ? found->second : field.unknown;
+        return true;
+    }
+    }
+
+    DriverLog("%s: %s has the wrong type, using the default\n", source.c_str(), field.key);
+    return false;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Bind every field of scope from one record, fields that are missing
+// or invalid are taken from defaults, or the built-in default without one
+//-----------------------------------------------------------------------------
+static void BindRecord(const CompiledProfile& profile, size_t record, ConfigFieldScope scope, Config& config, size_t index, const std::string& source, const Config* defaults)
+{
+    uint32_t record_count = HeaderOf(profile).record_count;
+    const char* strings = (const char*)profile.data() + StringsAt(record_count);
+
+    for (size_t i = 0; i < k_num_config_fields; ++i) {
+        const ConfigField& field = config_fields[i];
+        if (field.scope != scope) {
+            continue;
+        }
+        SidecarValue value = ValueAt(profile, record_count, record, i);
+        if (value.kind != VALUE_MISSING && ReadField(field, value, strings, config, index, source)) {
+            continue;
+        }
+        if (defaults) {
+            CopyField(field, *defaults, config, index);
+        }
+        else {
+            ResetField(field, config, index);
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: A field's current value as JSON
+//-----------------------------------------------------------------------------
+static nlohmann::ordered_json WriteField(const ConfigField& field, const Config& config, size_t index)
+{
+    switch (field.type) {
+    case FIELD_INT:
+        return FieldRef(config, field.int_member, field.int_list, index);
+    case FIELD_FLOAT:
+        return FieldRef(config, field.float_member, field.float_list, index);
+    case FIELD_BOOL:
+        return config.*field.bool_member;
+    case FIELD_STRING:
+    case FIELD_ENUM:
+        return FieldRef(config, field.string_member, field.string_list, index);
+    }
+    return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: A field's default as JSON
+//-----------------------------------------------------------------------------
+static nlohmann::ordered_json DefaultField(const ConfigField& field)
+{
+    switch (field.type) {
+    case FIELD_INT:
+        return (int32_t)field.def;
+    case FIELD_FLOAT:
+        return field.def;
+    case FIELD_BOOL:
+        return field.def != 0.0;
+    case FIELD_STRING:
+    case FIELD_ENUM:
+        return field.def_str;
+    }
+    return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Compile a parsed JSON config file into the sidecar layout. Keys
+// that aren't settings are reported here, once per change of the file.
+//-----------------------------------------------------------------------------
+CompiledProfile CompileProfile(const nlohmann::json& object, uint64_t json_size, uint64_t json_write_time, const std::string& source)
+{
+    uint32_t flags = 0;
+    std::vector<const nlohmann::json*> records = { &object };
+    if (object.is_object()) {
+        auto users = object.find(k_user_settings_key);
+        if (users != object.end() && users->is_array()) {
+            flags |= k_sidecar_user_settings;
+            for (const auto& entry : *users) {
+                records.push_back(&entry);
+            }
+        }
+    }
+
+    std::vector<SidecarValue> values(records.size() * k_num_config_fields);
+    std::string strings;
+    for (size_t record = 0; record < records.size(); ++record) {
+        if (!records[record]->is_object()) {
+            continue;
+        }
+        for (auto item = records[record]->begin(); item != records[record]->end(); ++item) {
+            const ConfigField* field = FindField(item.key());
+            if (!field) {
+                if (record != 0 || item.key() != k_user_settings_key) {
+                    DriverLog("%s: unknown setting %s\n", source.c_str(), item.key().c_str());
+                }
+                continue;
+            }
+            // User fields only count inside user_settings entries & vice versa
+            if ((field->scope == SCOPE_USER) != (record != 0)) {
+                continue;
+            }
+
+            SidecarValue& value = values[record * k_num_config_fields + (field - config_fields)];
+            const nlohmann::json& json = item.value();
+            if (json.is_number()) {
+                value.kind = VALUE_NUMBER;
+                value.number = json.get<double>();
+            }
+            else if (json.is_boolean()) {
+                value.kind = VALUE_BOOL;
+                value.number = json.get<bool>() ? 1.0 : 0.0;
+            }
+            else if (json.is_string()) {
+                const std::string& text = json.get_ref<const std::string&>();
+                value.kind = VALUE_STRING;
+                value.offset = strings.size();
+                value.length = (uint32_t)text.size();
+                strings += text;
+            }
+            else {
+                value.kind = VALUE_OTHER;
+            }
+        }
+    }
+
+    SidecarHeader header = { k_sidecar_magic, k_sidecar_version, json_size, json_write_time, LayoutHash(), (uint32_t)records.size(), flags, (uint32_t)strings.size() };
+    CompiledProfile profile(StringsAt(header.record_count) + strings.size());
+    memcpy(profile.data(), &header, sizeof(header));
+    memcpy(profile.data() + sizeof(header), values.data(), values.size() * sizeof(SidecarValue));
+    memcpy(profile.data() + StringsAt(header.record_count), strings.data(), strings.size());
+    return profile;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Check a sidecar read back from disk before it is bound: it has to
+// be this build's layout, compiled from this exact JSON and in bounds
+//-----------------------------------------------------------------------------
+bool ValidateProfile(const uint8_t* data, size_t size, uint64_t json_size, uint64_t json_write_time)
+{
+    SidecarHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != k_sidecar_magic || header.version != k_sidecar_version || header.layout != LayoutHash() ||
+        header.json_size != json_size || header.json_write_time != json_write_time || header.record_count == 0 ||
+        header.record_count > (size - sizeof(header)) / (k_num_config_fields * sizeof(SidecarValue)) ||
+        StringsAt(header.record_count) + header.string_size != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < (size_t)header.record_count * k_num_config_fields; ++i) {
+        SidecarValue value;
+        memcpy(&value, data + sizeof(header) + i * sizeof(value), sizeof(value));
+        if (value.kind > VALUE_OTHER || (value.kind == VALUE_NUMBER && !std::isfinite(value.number)) ||
+            (value.kind == VALUE_STRING && (value.offset > header.string_size || value.length > header.string_size - value.offset))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Bind the display settings, only default_config.json has these
+//-----------------------------------------------------------------------------
+void BindParams(const CompiledProfile& profile, StereoDisplayDriverConfiguration& config, const std::string& source)
+{
+    BindRecord(profile, 0, SCOPE_PARAMS, config, 0, source, nullptr);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Bind the profile settings & user settings. Anything the profile
+// leaves out comes from defaults, a profile without a user_settings array
+// gets all of the default user settings.
+//-----------------------------------------------------------------------------
+void BindProfile(const CompiledProfile& profile, StereoDisplayDriverConfiguration& config, const std::string& source, const StereoDisplayDriverConfiguration* defaults)
+{
+    BindRecord(profile, 0, SCOPE_PROFILE, config, 0, source, defaults);
+
+    SidecarHeader header = HeaderOf(profile);
+    bool has_users = (header.flags & k_sidecar_user_settings) != 0;
+    bool inherit_users = defaults && !has_users;
+
+    // Resize vectors based on the size of the user_settings array
+    config.num_user_settings = inherit_users ? defaults->num_user_settings : has_users ? header.record_count - 1 : 0;
+    config.user_key_type.resize(config.num_user_settings);
+    config.user_depth.resize(config.num_user_settings);
+    config.user_convergence.resize(config.num_user_settings);
+    config.prev_depth.resize(config.num_user_settings);
+    config.prev_convergence.resize(config.num_user_settings);
+    config.was_held.resize(config.num_user_settings);
+    config.user_load_str.resize(config.num_user_settings);
+    config.user_store_str.resize(config.num_user_settings);
+    config.user_type_str.resize(config.num_user_settings);
+
+    for (size_t i = 0; i < config.num_user_settings; ++i) {
+        BindRecord(profile, inherit_users ? k_no_record : i + 1, SCOPE_USER, config, i, source, defaults);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: The profile settings & user settings of config as JSON
+//-----------------------------------------------------------------------------
+nlohmann::ordered_json ProfileToJson(const StereoDisplayDriverConfiguration& config)
+{
+    nlohmann::ordered_json jsonConfig;
+    for (const auto& field : config_fields) {
+        if (field.scope == SCOPE_PROFILE) {
+            jsonConfig[field.key] = WriteField(field, config, 0);
+        }
+    }
+
+    // Store user settings as an array
+    for (size_t i = 0; i < config.num_user_settings; i++) {
+        nlohmann::ordered_json userSettings;
+        for (const auto& field : config_fields) {
+            if (field.scope == SCOPE_USER) {
+                userSettings[field.key] = WriteField(field, config, i);
+            }
+        }
+
+        // Append to JSON array in the main config
+        jsonConfig[k_user_settings_key].push_back(userSettings);
+    }
+    return jsonConfig;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: The built-in default of every display & profile setting as JSON
+//-----------------------------------------------------------------------------
+nlohmann::ordered_json DefaultsToJson()
+{
+    nlohmann::ordered_json defaultConfig;
+    for (const auto& field : config_fields) {
+        if (field.scope != SCOPE_USER) {
+            defaultConfig[field.key] = DefaultField(field);
+        }
+    }
+    return defaultConfig;
+}
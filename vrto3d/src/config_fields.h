@@ -0,0 +1,39 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+struct StereoDisplayDriverConfiguration;
+
+// A JSON config file compiled to the fixed sidecar layout described in
+// config_fields.cpp. Empty for a file that doesn't exist.
+using CompiledProfile = std::vector<uint8_t>;
+
+static constexpr const char* k_user_settings_key = "user_settings";
+
+CompiledProfile CompileProfile(const nlohmann::json& object, uint64_t json_size, uint64_t json_write_time, const std::string& source);
+bool ValidateProfile(const uint8_t* data, size_t size, uint64_t json_size, uint64_t json_write_time);
+
+void BindParams(const CompiledProfile& profile, StereoDisplayDriverConfiguration& config, const std::string& source);
+void BindProfile(const CompiledProfile& profile, StereoDisplayDriverConfiguration& config, const std::string& source, const StereoDisplayDriverConfiguration* defaults);
+
+nlohmann::ordered_json ProfileToJson(const StereoDisplayDriverConfiguration& config);
+nlohmann::ordered_json DefaultsToJson();
@@ -0,0 +1,163 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "frame_pacer.h"
+#include "driverlog.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+
+FramePacer::FramePacer( std::chrono::nanoseconds period )
+    : period_( std::chrono::duration_cast< Clock::duration >( period ) ), timer_( nullptr )
+{
+    // High resolution waitable timers are available on Windows 10 1803+
+    // Fall back to a plain sleep with a wider spin window on older systems
+    timer_ = CreateWaitableTimerExW( NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS );
+    if ( timer_ )
+        spin_margin_ = std::chrono::microseconds( 500 );
+    else
+        spin_margin_ = std::chrono::milliseconds( 2 );
+
+    Start();
+}
+
+
+FramePacer::~FramePacer()
+{
+    if ( timer_ )
+        CloseHandle( ( HANDLE )timer_ );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Reset the deadline grid to now and clear the jitter statistics
+//-----------------------------------------------------------------------------
+void FramePacer::Start()
+{
+    deadline_ = Clock::now();
+    histogram_.fill( 0 );
+    ticks_ = 0;
+    overruns_ = 0;
+    skipped_ = 0;
+    max_late_us_ = 0;
+    total_late_us_ = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Block until the next deadline on the period grid
+//-----------------------------------------------------------------------------
+void FramePacer::Wait()
+{
+    deadline_ += period_;
+    auto now = Clock::now();
+
+    if ( now >= deadline_ )
+    {
+        // Overran the period: run the next iteration immediately to catch up,
+        // but drop whole periods that were missed instead of bursting through them
+        overruns_++;
+        auto missed = ( now - deadline_ ) / period_;
+        if ( missed > 0 )
+        {
+            skipped_ += missed;
+            deadline_ += missed * period_;
+        }
+        Record( now - deadline_ );
+        return;
+    }
+
+    if ( deadline_ - now > spin_margin_ )
+        SleepUntil( deadline_ - spin_margin_ );
+
+    // Spin out the remainder for sub-millisecond accuracy
+    while ( ( now = Clock::now() ) < deadline_ )
+        std::this_thread::yield();
+
+    Record( now - deadline_ );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Coarse sleep until the given time
+//-----------------------------------------------------------------------------
+void FramePacer::SleepUntil( Clock::time_point wake )
+{
+    if ( timer_ )
+    {
+        // Relative due time in 100ns units is given as a negative value
+        LARGE_INTEGER due;
+        due.QuadPart = -std::chrono::duration_cast< std::chrono::duration< LONGLONG, std::ratio< 1, 10000000 > > >( wake - Clock::now() ).count();
+        if ( due.QuadPart < 0 && SetWaitableTimer( ( HANDLE )timer_, &due, 0, NULL, NULL, FALSE ) )
+        {
+            WaitForSingleObject( ( HANDLE )timer_, INFINITE );
+            return;
+        }
+    }
+    std::this_thread::sleep_until( wake );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Add a wake-up lateness sample to the jitter histogram
+//-----------------------------------------------------------------------------
+void FramePacer::Record( Clock::duration late )
+{
+    int64_t late_us = std::chrono::duration_cast< std::chrono::microseconds >( late ).count();
+    size_t bucket = 0;
+    while ( bucket < k_bucket_limits_us.size() && late_us >= k_bucket_limits_us[ bucket ] )
+        bucket++;
+
+    histogram_[ bucket ]++;
+    ticks_++;
+    total_late_us_ += late_us;
+    if ( late_us > max_late_us_ )
+        max_late_us_ = late_us;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Write the pacing statistics for this run to the driver log
+//-----------------------------------------------------------------------------
+void FramePacer::LogStats( const char *name ) const
+{
+    if ( ticks_ == 0 )
+        return;
+
+    std::string buckets;
+    char entry[ 32 ];
+    for ( size_t i = 0; i < histogram_.size(); i++ )
+    {
+        if ( i < k_bucket_limits_us.size() )
+            snprintf( entry, sizeof( entry ), " <%lldus:%llu", ( long long )k_bucket_limits_us[ i ], ( unsigned long long )histogram_[ i ] );
+        else
+            snprintf( entry, sizeof( entry ), " >=%lldus:%llu", ( long long )k_bucket_limits_us.back(), ( unsigned long long )histogram_[ i ] );
+        buckets += entry;
+    }
+
+    DriverLog( "%s pacing: %llu ticks, %llu overruns, %llu skipped, mean late %lldus, max late %lldus\n",
+        name, ( unsigned long long )ticks_, ( unsigned long long )overruns_, ( unsigned long long )skipped_,
+        ( long long )( total_late_us_ / ( int64_t )ticks_ ), ( long long )max_late_us_ );
+    DriverLog( "%s jitter:%s\n", name, buckets.c_str() );
+}
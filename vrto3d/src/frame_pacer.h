@@ -0,0 +1,63 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Paces a loop against absolute deadlines on a fixed period grid.
+// Sleeps until shortly before each deadline and spins the remainder, so the
+// period doesn't drift or truncate to whole milliseconds. Wake-up jitter is
+// recorded into a histogram that is logged once per run.
+//-----------------------------------------------------------------------------
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FramePacer( std::chrono::nanoseconds period );
+    ~FramePacer();
+
+    void Start();
+    void Wait();
+    void LogStats( const char *name ) const;
+
+    Clock::duration Period() const { return period_; }
+
+private:
+    // Bucket upper bounds in microseconds, the last bucket is open-ended
+    static constexpr std::array< int64_t, 7 > k_bucket_limits_us = { 50, 100, 250, 500, 1000, 2000, 4000 };
+
+    void SleepUntil( Clock::time_point wake );
+    void Record( Clock::duration late );
+
+    Clock::duration period_;
+    Clock::duration spin_margin_;
+    Clock::time_point deadline_;
+
+    void *timer_;
+
+    std::array< uint64_t, k_bucket_limits_us.size() + 1 > histogram_;
+    uint64_t ticks_;
+    uint64_t overruns_;
+    uint64_t skipped_;
+    int64_t max_late_us_;
+    int64_t total_late_us_;
+};
@@ -0,0 +1,103 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "gamepad_poller.h"
+#include "driverlog.h"
+
+#include <algorithm>
+
+
+GamepadPoller::GamepadPoller( std::unique_ptr< IGamepadBackend > backend, Clock::duration reprobe_interval )
+    : backend_( std::move( backend ) ), reprobe_interval_( reprobe_interval ), next_probe_slot_( 0 )
+{
+    for ( auto &slot : slots_ )
+    {
+        slot.connected = false;
+        slot.next_probe = Clock::time_point::min();
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Poll all due slots, returns true if any controller is connected
+//-----------------------------------------------------------------------------
+bool GamepadPoller::Poll( Clock::time_point now, GamepadState &merged )
+{
+    merged = {};
+    bool any_connected = false;
+
+    // Pick at most one disconnected slot that is due for a re-probe this tick
+    uint32_t probe_slot = k_max_slots;
+    for ( uint32_t i = 0; i < k_max_slots; i++ )
+    {
+        uint32_t slot = ( next_probe_slot_ + i ) % k_max_slots;
+        if ( !slots_[ slot ].connected && now >= slots_[ slot ].next_probe )
+        {
+            probe_slot = slot;
+            next_probe_slot_ = ( slot + 1 ) % k_max_slots;
+            break;
+        }
+    }
+
+    for ( uint32_t slot = 0; slot < k_max_slots; slot++ )
+    {
+        SlotState &slot_state = slots_[ slot ];
+        if ( !slot_state.connected && slot != probe_slot )
+            continue;
+
+        GamepadState state = {};
+        bool connected = backend_->GetState( slot, state );
+        if ( connected != slot_state.connected )
+            DriverLog( "Controller %u %s\n", slot + 1, connected ? "connected" : "disconnected" );
+
+        slot_state.connected = connected;
+        if ( connected )
+        {
+            Merge( state, merged );
+            any_connected = true;
+        }
+        else
+        {
+            slot_state.next_probe = now + reprobe_interval_;
+        }
+    }
+
+    return any_connected;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Combine pads: buttons are OR'd, triggers take the largest pull and
+// each stick comes from whichever pad deflects it the most
+//-----------------------------------------------------------------------------
+void GamepadPoller::Merge( const GamepadState &state, GamepadState &merged )
+{
+    merged.buttons |= state.buttons;
+    merged.left_trigger = std::max( merged.left_trigger, state.left_trigger );
+    merged.right_trigger = std::max( merged.right_trigger, state.right_trigger );
+
+    auto magnitude = []( int16_t x, int16_t y ) { return ( int64_t )x * x + ( int64_t )y * y; };
+    if ( magnitude( state.thumb_lx, state.thumb_ly ) > magnitude( merged.thumb_lx, merged.thumb_ly ) )
+    {
+        merged.thumb_lx = state.thumb_lx;
+        merged.thumb_ly = state.thumb_ly;
+    }
+    if ( magnitude( state.thumb_rx, state.thumb_ry ) > magnitude( merged.thumb_rx, merged.thumb_ry ) )
+    {
+        merged.thumb_rx = state.thumb_rx;
+        merged.thumb_ry = state.thumb_ry;
+    }
+}
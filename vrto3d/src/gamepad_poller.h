@@ -0,0 +1,72 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "input_bus.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Source of raw controller state, one call per user slot
+//-----------------------------------------------------------------------------
+class IGamepadBackend
+{
+public:
+    virtual ~IGamepadBackend() = default;
+
+    // Returns false if no controller is connected in the slot
+    virtual bool GetState( uint32_t slot, GamepadState &state ) = 0;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Polls every controller slot and merges them into one state.
+// Connected slots are polled every tick. Disconnected slots are only
+// re-probed after a back-off interval, and at most one per tick, because
+// probing an empty slot can stall for milliseconds.
+//-----------------------------------------------------------------------------
+class GamepadPoller
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t k_max_slots = 4;
+
+    explicit GamepadPoller( std::unique_ptr< IGamepadBackend > backend,
+        Clock::duration reprobe_interval = std::chrono::seconds( 2 ) );
+
+    bool Poll( Clock::time_point now, GamepadState &merged );
+    bool IsConnected( uint32_t slot ) const { return slots_[ slot ].connected; }
+
+private:
+    struct SlotState
+    {
+        bool connected;
+        Clock::time_point next_probe;
+    };
+
+    static void Merge( const GamepadState &state, GamepadState &merged );
+
+    std::unique_ptr< IGamepadBackend > backend_;
+    Clock::duration reprobe_interval_;
+    std::array< SlotState, k_max_slots > slots_;
+    uint32_t next_probe_slot_;
+};
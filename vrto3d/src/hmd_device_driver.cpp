@@ -1,1056 +1,1283 @@
-/*
- * This file is part of VRto3D.
- *
- * VRto3D is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * VRto3D is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
- * GNU Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public License
- * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
- */
-#include "hmd_device_driver.h"
-#include "key_mappings.h"
-#include "driverlog.h"
-#include "vrmath.h"
-
-#include <string>
-#include <sstream>
-#include <ctime>
-
-#include <windows.h>
-#include <xinput.h>
-#include <nlohmann/json.hpp>
-
-// Link the XInput library
-#pragma comment(lib, "XInput.lib")
-
-//-----------------------------------------------------------------------------
-// Purpose:
-// Set a function pointer to the xinput get state call. By default, set it to
-// XInputGetState() in whichever xinput we are linked to (xinput9_1_0.dll). If
-// the d3dx.ini is using the guide button we will try to switch to either
-// xinput 1.3 or 1.4 to get access to the undocumented XInputGetStateEx() call.
-// We can't rely on these existing on Win7 though, so if we fail to load them
-// don't treat it as fatal and continue using the original one.
-//-----------------------------------------------------------------------------
-static HMODULE xinput_lib;
-typedef DWORD(WINAPI* tXInputGetState)(DWORD dwUserIndex, XINPUT_STATE* pState);
-static tXInputGetState _XInputGetState = XInputGetState;
-static void SwitchToXinpuGetStateEx()
-{
-    tXInputGetState XInputGetStateEx;
-
-    if (xinput_lib)
-        return;
-
-    // 3DMigoto is linked against xinput9_1_0.dll, but that version does
-    // not export XInputGetStateEx to get the guide button. Try loading
-    // xinput 1.3 and 1.4, which both support this functionality.
-    xinput_lib = LoadLibrary(L"xinput1_3.dll");
-    if (xinput_lib) {
-        DriverLog("Loaded xinput1_3.dll for guide button support\n");
-    }
-    else {
-        xinput_lib = LoadLibrary(L"xinput1_4.dll");
-        if (xinput_lib) {
-            DriverLog("Loaded xinput1_4.dll for guide button support\n");
-        }
-        else {
-            DriverLog("ERROR: Unable to load xinput 1.3 or 1.4: Guide button will not be available\n");
-            return;
-        }
-    }
-
-    // Unnamed and undocumented exports FTW
-    LPCSTR XInputGetStateExOrdinal = (LPCSTR)100;
-    XInputGetStateEx = (tXInputGetState)GetProcAddress(xinput_lib, XInputGetStateExOrdinal);
-    if (!XInputGetStateEx) {
-        DriverLog("ERROR: Unable to get XInputGetStateEx: Guide button will not be available\n");
-        return;
-    }
-
-    _XInputGetState = XInputGetStateEx;
-}
-
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Signify Operation Success
-//-----------------------------------------------------------------------------
-static void BeepSuccess()
-{
-    // High beep for success
-    Beep(1800, 400);
-}
-
-
-// Load settings from default.vrsettings
-static const char *stereo_main_settings_section = "driver_vrto3d";
-
-MockControllerDeviceDriver::MockControllerDeviceDriver()
-{
-    // Keep track of whether Activate() has been called
-    is_active_ = false;
-    vr::DriverPose_t curr_pose_ = { 0 };
-    app_name_ = "";
-
-    auto* vrs = vr::VRSettings();
-    JsonManager json_manager;
-    json_manager.EnsureDefaultConfigExists();
-
-    char model_number[ 1024 ];
-    vrs->GetString( stereo_main_settings_section, "model_number", model_number, sizeof( model_number ) );
-    stereo_model_number_ = model_number;
-    char serial_number[ 1024 ];
-    vrs->GetString( stereo_main_settings_section, "serial_number", serial_number, sizeof( serial_number ) );
-    stereo_serial_number_ = serial_number;
-
-    DriverLog( "VRto3D Model Number: %s", stereo_model_number_.c_str() );
-    DriverLog( "VRto3D Serial Number: %s", stereo_serial_number_.c_str() );
-
-    SwitchToXinpuGetStateEx();
-
-    // Display settings
-    StereoDisplayDriverConfiguration display_configuration{};
-    display_configuration.window_x = 0;
-    display_configuration.window_y = 0;
-    json_manager.LoadParamsFromJson(display_configuration);
-
-    // Profile settings
-    json_manager.LoadProfileFromJson(DEF_CFG, display_configuration);
-
-    // Instantiate our display component
-    stereo_display_component_ = std::make_unique< StereoDisplayComponent >( display_configuration );
-
-    DriverLog("Default Config Loaded\n");
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Initialize all settings and notify SteamVR
-//-----------------------------------------------------------------------------
-vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
-{
-    device_index_ = unObjectId;
-    is_active_ = true;
-    is_on_top_ = false;
-
-    // A list of properties available is contained in vr::ETrackedDeviceProperty.
-    auto* vrp = vr::VRProperties();
-    auto* vrs = vr::VRSettings();
-    vr::PropertyContainerHandle_t container = vrp->TrackedDeviceToPropertyContainer( device_index_ );
-    vrp->SetStringProperty( container, vr::Prop_ModelNumber_String, stereo_model_number_.c_str() );
-    vrp->SetStringProperty( container, vr::Prop_ManufacturerName_String, "VRto3D");
-    vrp->SetStringProperty( container, vr::Prop_TrackingFirmwareVersion_String, "1.0");
-    vrp->SetStringProperty( container, vr::Prop_HardwareRevision_String, "1.0");
-
-    // Display settings
-    vrp->SetFloatProperty( container, vr::Prop_UserIpdMeters_Float, stereo_display_component_->GetConfig().depth);
-    vrp->SetFloatProperty( container, vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f);
-    vrp->SetFloatProperty( container, vr::Prop_DisplayFrequency_Float, stereo_display_component_->GetConfig().display_frequency * 1.5f );
-    vrp->SetFloatProperty( container, vr::Prop_SecondsFromVsyncToPhotons_Float, stereo_display_component_->GetConfig().display_latency);
-    vrp->SetFloatProperty( container, vr::Prop_SecondsFromPhotonsToVblank_Float, 0.0);
-    vrp->SetBoolProperty( container, vr::Prop_ReportsTimeSinceVSync_Bool, false);
-    vrp->SetBoolProperty( container, vr::Prop_IsOnDesktop_Bool, !stereo_display_component_->GetConfig().debug_enable);
-    vrp->SetBoolProperty( container, vr::Prop_DisplayDebugMode_Bool, stereo_display_component_->GetConfig().debug_enable);
-    vrp->SetBoolProperty( container, vr::Prop_HasDriverDirectModeComponent_Bool, false);
-    if (stereo_display_component_->GetConfig().depth_gauge)
-    {
-        vrp->SetFloatProperty(container, vr::Prop_DashboardScale_Float, 1.0f);
-    }
-    else
-    {
-        vrp->SetFloatProperty(container, vr::Prop_DashboardScale_Float, 0.0f);
-    }
-
-    // Set the chaperone JSON property
-    // Get the current time
-    std::time_t t = std::time(nullptr);
-    std::tm tm;
-    localtime_s(&tm, &t);
-    // Construct the JSON string with variables
-    std::stringstream ss;
-    ss << R"(
-        {
-           "jsonid" : "chaperone_info",
-           "universes" : [
-              {
-                 "collision_bounds" : [
-                    [
-                       [ -1.0, 0.0, -1.0 ],
-                       [ -1.0, 3.0, -1.0 ],
-                       [ -1.0, 3.0, 1.0 ],
-                       [ -1.0, 0.0, 1.0 ]
-                    ],
-                    [
-                       [ -1.0, 0.0, 1.0 ],
-                       [ -1.0, 3.0, 1.0 ],
-                       [ 1.0, 3.0, 1.0 ],
-                       [ 1.0, 0.0, 1.0 ]
-                    ],
-                    [
-                       [ 1.0, 0.0, 1.0 ],
-                       [ 1.0, 3.0, 1.0 ],
-                       [ 1.0, 3.0, -1.0 ],
-                       [ 1.0, 0.0, -1.0 ]
-                    ],
-                    [
-                       [ 1.0, 0.0, -1.0 ],
-                       [ 1.0, 3.0, -1.0 ],
-                       [ -1.0, 3.0, -1.0 ],
-                       [ -1.0, 0.0, -1.0 ]
-                    ]
-                 ],
-                 "play_area" : [ 2.0, 2.0 ],
-                 "seated" : {
-                    "translation" : [ 0.0, 0.5, 0.0 ],
-                    "yaw" : 0.0
-                 },
-                 "standing" : {
-                    "translation" : [ 0.0, 1.0, 0.0 ],
-                    "yaw" : 0.0
-                 },
-                 "time" : ")" << std::put_time(&tm, "%a %b %d %H:%M:%S %Y") << R"(",
-                 "universeID" : "64"
-              }
-           ],
-           "version" : 5
-        }
-        )";
-    // Convert the stringstream to a string
-    std::string chaperoneJson = ss.str();
-    // Set the chaperone JSON property
-    vrp->SetStringProperty(container, vr::Prop_DriverProvidedChaperoneJson_String, chaperoneJson.c_str());
-    vrp->SetUint64Property(container, vr::Prop_CurrentUniverseId_Uint64, 64);
-    vrs->SetInt32(vr::k_pch_CollisionBounds_Section, vr::k_pch_CollisionBounds_Style_Int32, vr::COLLISION_BOUNDS_STYLE_NONE);
-    vrs->SetBool(vr::k_pch_CollisionBounds_Section, vr::k_pch_CollisionBounds_GroundPerimeterOn_Bool, false);
-
-    // Miscellaneous settings
-    vrp->SetBoolProperty( container, vr::Prop_WillDriftInYaw_Bool, false);
-    vrp->SetBoolProperty( container, vr::Prop_DeviceIsWireless_Bool, false);
-    vrp->SetBoolProperty( container, vr::Prop_DeviceIsCharging_Bool, false);
-    vrp->SetBoolProperty( container, vr::Prop_ContainsProximitySensor_Bool, false);
-    vrp->SetBoolProperty( container, vr::Prop_DeviceCanPowerOff_Bool, false);
-
-    // set proximity senser to always on, always head present
-    vr::VRInputComponentHandle_t  prox;
-    vr::VRDriverInput()->CreateBooleanComponent(container, "/proximity", &prox);
-    vr::VRDriverInput()->UpdateBooleanComponent(prox, true, 0.0);
-    
-    // Miscellaneous settings
-    vrs->SetBool(vr::k_pch_DirectMode_Section, vr::k_pch_DirectMode_Enable_Bool, false);
-    vrs->SetFloat(vr::k_pch_Power_Section, vr::k_pch_Power_TurnOffScreensTimeout_Float, 86400.0f);
-    vrs->SetBool(vr::k_pch_Power_Section, vr::k_pch_Power_PauseCompositorOnStandby_Bool, false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, vr::k_pch_Dashboard_EnableDashboard_Bool, false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, vr::k_pch_Dashboard_ArcadeMode_Bool, true);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, "allowAppQuitting", false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, "autoShowGameTheater", false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, "showDesktop", false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, "showPowerOptions", false);
-    vrs->SetBool(vr::k_pch_Dashboard_Section, "inputCaptureEnabled", false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_EnableHomeApp, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_MirrorViewVisibility_Bool, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_EnableSafeMode, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_DisplayDebug_Bool, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_MotionSmoothing_Bool, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_DisableAsyncReprojection_Bool, true);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_AllowSupersampleFiltering_Bool, false);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_SupersampleManualOverride_Bool, true);
-    vrs->SetBool(vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_ForceFadeOnBadTracking_Bool, false);
-    
-    pose_thread_ = std::thread(&MockControllerDeviceDriver::PoseUpdateThread, this);
-    hotkey_thread_ = std::thread(&MockControllerDeviceDriver::PollHotkeysThread, this);
-    focus_thread_ = std::thread(&MockControllerDeviceDriver::FocusUpdateThread, this);
-
-    HANDLE thread_handle = pose_thread_.native_handle();
-
-    // Set the thread priority
-    if (!SetThreadPriority(thread_handle, THREAD_PRIORITY_HIGHEST)) {
-        // Handle error if setting priority fails
-        DriverLog("Failed to set thread priority: %d\n", GetLastError());
-    }
-
-    DriverLog("Activation Complete\n");
-
-    return vr::VRInitError_None;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Return StereoDisplayComponent as vr::IVRDisplayComponent
-//-----------------------------------------------------------------------------
-void *MockControllerDeviceDriver::GetComponent( const char *pchComponentNameAndVersion )
-{
-    if ( strcmp( pchComponentNameAndVersion, vr::IVRDisplayComponent_Version ) == 0 )
-    {
-        return stereo_display_component_.get();
-    }
-
-    return nullptr;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: This is called by vrserver when a debug request has been made from an application to the driver.
-// What is in the response and request is up to the application and driver to figure out themselves.
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::DebugRequest( const char *pchRequest, char *pchResponseBuffer, uint32_t unResponseBufferSize )
-{
-    if ( unResponseBufferSize >= 1 )
-        pchResponseBuffer[ 0 ] = 0;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Static Pose with pitch & yaw adjustment
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::PoseUpdateThread()
-{
-    static float currentPitch = 0.0f; // Keep track of the current pitch
-    static vr::HmdQuaternion_t currentYawQuat = { 1.0f, 0.0f, 0.0f, 0.0f }; // Initial yaw quaternion
-    static float lastPitch = 0.0f;
-    static float lastYaw = 0.0f;
-    static vr::DriverPose_t lastPose = { 0 };
-
-    auto lastTime = std::chrono::high_resolution_clock::now();
-
-    while (is_active_)
-    {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto deltaTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTime - lastTime).count();
-        lastTime = currentTime;
-
-        XINPUT_STATE state;
-        ZeroMemory(&state, sizeof(XINPUT_STATE));
-        bool got_xinput = (_XInputGetState(0, &state) == ERROR_SUCCESS);
-
-        auto config = stereo_display_component_->GetConfig();
-
-        vr::DriverPose_t pose = { 0 };
-
-        pose.qWorldFromDriverRotation = HmdQuaternion_Identity;
-        pose.qDriverFromHeadRotation = HmdQuaternion_Identity;
-        pose.qRotation = HmdQuaternion_Identity;
-
-        // Adjust pitch based on controller input
-        if (config.pitch_enable && got_xinput)
-        {
-            float normalizedY = state.Gamepad.sThumbRY / 32767.0f;
-
-            // Apply deadzone
-            if (std::abs(normalizedY) < config.ctrl_deadzone)
-            {
-                normalizedY = 0.0f;
-            }
-            else
-            {
-                if (normalizedY > 0)
-                    normalizedY = (normalizedY - config.ctrl_deadzone) / (1.0f - config.ctrl_deadzone);
-                else
-                    normalizedY = (normalizedY + config.ctrl_deadzone) / (1.0f - config.ctrl_deadzone);
-            }
-
-            // Scale Pitch
-            currentPitch += (normalizedY * config.ctrl_sensitivity);
-            if (currentPitch > 90.0f) currentPitch = 90.0f;
-            if (currentPitch < -90.0f) currentPitch = -90.0f;
-        }
-
-        // Adjust yaw based on controller input
-        if (config.yaw_enable && got_xinput)
-        {
-            float normalizedX = state.Gamepad.sThumbRX / 32767.0f;
-
-            // Apply deadzone
-            if (std::abs(normalizedX) < config.ctrl_deadzone)
-            {
-                normalizedX = 0.0f;
-            }
-            else
-            {
-                if (normalizedX > 0)
-                    normalizedX = (normalizedX - config.ctrl_deadzone) / (1.0f - config.ctrl_deadzone);
-                else
-                    normalizedX = (normalizedX + config.ctrl_deadzone) / (1.0f - config.ctrl_deadzone);
-            }
-
-            // Scale Yaw
-            float yawAdjustment = -normalizedX * config.ctrl_sensitivity;
-
-            // Create a quaternion for the yaw adjustment
-            vr::HmdQuaternion_t yawQuatAdjust = QuaternionFromAxisAngle(0.0f, 1.0f, 0.0f, DEG_TO_RAD(yawAdjustment));
-
-            // Update the current yaw quaternion
-            currentYawQuat = HmdQuaternion_Normalize(yawQuatAdjust * currentYawQuat);
-        }
-
-        // Reset Pose to origin
-        if (config.pose_reset)
-        {
-            currentPitch = 0.0f;
-            currentYawQuat = { 1.0f, 0.0f, 0.0f, 0.0f };
-            stereo_display_component_->SetReset();
-        }
-
-        float pitchRadians = DEG_TO_RAD(currentPitch);
-        float yawRadians = 2.0f * acos(currentYawQuat.w);
-
-        // Recompose the rotation quaternion from pitch and yaw
-        vr::HmdQuaternion_t pitchQuaternion = QuaternionFromAxisAngle(1.0f, 0.0f, 0.0f, pitchRadians);
-        pose.qRotation = HmdQuaternion_Normalize(currentYawQuat * pitchQuaternion);
-
-        // Calculate the new position relative to the current pitch & yaw
-        pose.vecPosition[0] = config.pitch_radius * cos(pitchRadians) * sin(yawRadians) - config.pitch_radius * sin(yawRadians);
-        pose.vecPosition[1] = config.hmd_height - config.pitch_radius * sin(pitchRadians);
-        pose.vecPosition[2] = config.pitch_radius * cos(pitchRadians) * cos(yawRadians) - config.pitch_radius * cos(yawRadians);
-        if (pose.vecPosition[1] < 0.0)
-        {
-            pose.vecPosition[1] = 0.0;
-        }
-
-        // Calculate velocity using known update interval
-        pose.vecVelocity[0] = (pose.vecPosition[0] - lastPose.vecPosition[0]) / deltaTime;
-        pose.vecVelocity[1] = (pose.vecPosition[1] - lastPose.vecPosition[1]) / deltaTime;
-        pose.vecVelocity[2] = (pose.vecPosition[2] - lastPose.vecPosition[2]) / deltaTime;
-        pose.vecAngularVelocity[0] = AngleDifference(pitchRadians, lastPitch) / deltaTime; // Pitch angular velocity
-        pose.vecAngularVelocity[1] = AngleDifference(yawRadians, lastYaw) / deltaTime; // Yaw angular velocity
-        pose.vecAngularVelocity[2] = 0.0f;
-
-        // Calculate acceleration based on change in velocity
-        pose.vecAcceleration[0] = (pose.vecVelocity[0] - lastPose.vecVelocity[0]) / deltaTime;
-        pose.vecAcceleration[1] = (pose.vecVelocity[1] - lastPose.vecVelocity[1]) / deltaTime;
-        pose.vecAcceleration[2] = (pose.vecVelocity[2] - lastPose.vecVelocity[2]) / deltaTime;
-        pose.vecAngularAcceleration[0] = (pose.vecAngularVelocity[0] - lastPose.vecAngularVelocity[0]) / deltaTime;
-        pose.vecAngularAcceleration[1] = (pose.vecAngularVelocity[1] - lastPose.vecAngularVelocity[1]) / deltaTime;
-        pose.vecAngularAcceleration[2] = 0.0f;
-
-        pose.poseIsValid = true;
-        pose.deviceIsConnected = true;
-        pose.result = vr::TrackingResult_Running_OK;
-        pose.shouldApplyHeadModel = false;
-        pose.willDriftInYaw = false;
-        pose.poseTimeOffset = 0;
-
-        // Update the pose
-        pose_mutex_.lock();
-        curr_pose_ = pose;
-        pose_mutex_.unlock();
-
-        // Update for next iteration
-        lastPitch = pitchRadians;
-        lastYaw = yawRadians;
-        lastPose = pose;
-
-        vr::VRServerDriverHost()->TrackedDevicePoseUpdated(device_index_, pose, sizeof(vr::DriverPose_t));
-
-        // XInput polling limit is 125Hz
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - currentTime);
-        std::this_thread::sleep_for(std::chrono::milliseconds(8) - elapsed);
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Return current pose
-//-----------------------------------------------------------------------------
-vr::DriverPose_t MockControllerDeviceDriver::GetPose()
-{
-    std::lock_guard<std::mutex> lock(pose_mutex_);
-    return curr_pose_;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Update HMD position, Depth, Convergence, and user binds
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::PollHotkeysThread()
-{
-    static int sleep_time = (int)(floor(1000.0 / stereo_display_component_->GetConfig().display_frequency));
-    static int height_sleep = 0;
-    static int top_sleep = 0;
-    static int save_sleep = 0;
-
-    while (is_active_)
-    {
-        if (!stereo_display_component_->GetConfig().disable_hotkeys) {
-            // Ctrl+F3 Decrease Depth
-            if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F3) & 0x8000)) {
-                stereo_display_component_->AdjustDepth(-0.001f, true, device_index_);
-            }
-            // Ctrl+F4 Increase Depth
-            else if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F4) & 0x8000)) {
-                stereo_display_component_->AdjustDepth(0.001f, true, device_index_);
-            }
-            // Ctrl+F5 Decrease Convergence
-            if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F5) & 0x8000)) {
-                stereo_display_component_->AdjustConvergence(-0.001f, true, device_index_);
-            }
-            // Ctrl+F6 Increase Convergence
-            else if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F6) & 0x8000)) {
-                stereo_display_component_->AdjustConvergence(0.001f, true, device_index_);
-            }
-            // Ctrl+F7 Store settings into game profile
-            if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F7) & 0x8000) && save_sleep == 0) {
-                auto config = stereo_display_component_->GetConfig();
-                save_sleep = config.sleep_count_max;
-                config.depth = stereo_display_component_->GetDepth();
-                config.convergence = stereo_display_component_->GetConvergence();
-                JsonManager json_manager;
-                json_manager.SaveProfileToJson(app_name_ + "_config.json", config);
-                BeepSuccess();
-            }
-            // Ctrl+F10 Reload settings from default.vrsettings
-            else if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F10) & 0x8000) && save_sleep == 0) {
-                auto config = stereo_display_component_->GetConfig();
-                save_sleep = config.sleep_count_max;
-                JsonManager json_manager;
-                if (json_manager.LoadProfileFromJson(DEF_CFG, config))
-                {
-                    stereo_display_component_->LoadSettings(config, device_index_);
-                    DriverLog("Loaded %s profile\n", DEF_CFG.c_str());
-                    BeepSuccess();
-                }
-            }
-            else if (save_sleep > 0) {
-                save_sleep--;
-            }
-        }
-        // Ctrl+F8 Toggle Always On Top
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F8) & 0x8000) && top_sleep == 0) {
-            top_sleep = stereo_display_component_->GetConfig().sleep_count_max;
-            is_on_top_ = !is_on_top_;
-        }
-        else if (top_sleep > 0) {
-            top_sleep--;
-        }
-        // Ctrl+F9 Toggle HMD height
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_F9) & 0x8000) && height_sleep == 0) {
-            height_sleep = stereo_display_component_->GetConfig().sleep_count_max;
-            stereo_display_component_->SetHeight();
-        }
-        else if (height_sleep > 0) {
-            height_sleep--;
-        }
-        // Ctrl+- Decrease Sensitivity
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_OEM_MINUS) & 0x8000)) {
-            stereo_display_component_->AdjustSensitivity(-0.01f);
-        }
-        // Ctrl++ Increase Sensitivity
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_OEM_PLUS) & 0x8000)) {
-            stereo_display_component_->AdjustSensitivity(0.01f);
-        }
-        // Ctrl+[ Decrease Pitch Radius
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_OEM_4) & 0x8000)) {
-            stereo_display_component_->AdjustRadius(-0.01f);
-        }
-        // Ctrl+] Increase Pitch Radius
-        if ((GetAsyncKeyState(VK_CONTROL) & 0x8000) && (GetAsyncKeyState(VK_OEM_6) & 0x8000)) {
-            stereo_display_component_->AdjustRadius(0.01f);
-        }
-
-        // Check User binds
-        stereo_display_component_->CheckUserSettings(device_index_);
-
-        // Sleep for ~ 1 frame
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Keep Headset Window on top if set
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::FocusUpdateThread()
-{
-    static int sleep_time = 1000;
-    static HWND vr_window = NULL;
-    static HWND top_window = NULL;
-
-    while (is_active_)
-    {
-        // Keep VR display always on top for 3D rendering
-        if (is_on_top_) {
-            top_window = GetTopWindow(GetDesktopWindow());
-            if (vr_window != NULL && vr_window != top_window) {
-                SetWindowPos(vr_window, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
-            }
-            else if (vr_window == NULL) {
-                vr_window = FindWindow(NULL, L"Headset Window");
-            }
-        }
-        else if (vr_window != NULL) {
-            SetWindowPos(vr_window, HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
-            vr_window = NULL;
-        }
-
-        // Sleep for 1s
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Load Game Specific Settings from Documents\My games\vrto3d\app_name_config.json
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::LoadSettings(const std::string& app_name)
-{
-    if (app_name != app_name_)
-    {
-        app_name_ = app_name;
-        auto config = stereo_display_component_->GetConfig();
-
-        // Attempt to read the JSON settings file
-        JsonManager json_manager;
-        if (json_manager.LoadProfileFromJson(app_name + "_config.json", config))
-        {
-            stereo_display_component_->LoadSettings(config, device_index_);
-            DriverLog("Loaded %s profile\n", app_name.c_str());
-            BeepSuccess();
-        }
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Stub for Standby mode
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::EnterStandby()
-{
-    DriverLog( "HMD has been put into standby." );
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Shutdown process
-//-----------------------------------------------------------------------------
-void MockControllerDeviceDriver::Deactivate()
-{
-    if ( is_active_.exchange( false ) )
-    {
-        pose_thread_.join();
-        hotkey_thread_.join();
-        focus_thread_.join();
-    }
-
-    // unassign our controller index (we don't want to be calling vrserver anymore after Deactivate() has been called
-    device_index_ = vr::k_unTrackedDeviceIndexInvalid;
-}
-
-
-//-----------------------------------------------------------------------------
-// DISPLAY DRIVER METHOD DEFINITIONS
-//-----------------------------------------------------------------------------
-
-StereoDisplayComponent::StereoDisplayComponent( const StereoDisplayDriverConfiguration &config )
-    : config_( config ), depth_(config.depth), convergence_(config.convergence)
-{
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: To inform vrcompositor if this display is considered an on-desktop display.
-//-----------------------------------------------------------------------------
-bool StereoDisplayComponent::IsDisplayOnDesktop()
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    return !config_.debug_enable;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: To as vrcompositor to search for this display.
-//-----------------------------------------------------------------------------
-bool StereoDisplayComponent::IsDisplayRealDisplay()
-{
-    return false;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: To inform the rest of the vr system what the recommended target size should be
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight )
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    *pnWidth = config_.render_width;
-    *pnHeight = config_.render_height;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Render in SbS or TaB Stereo3D
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::GetEyeOutputViewport( vr::EVREye eEye, uint32_t *pnX, uint32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight )
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    if (config_.reverse_enable)
-    {
-        eEye = static_cast<vr::EVREye>(!static_cast<bool> (eEye));
-    }
-    // Use Top and Bottom Rendering
-    if (config_.tab_enable)
-    {
-        *pnX = 0;
-        // Each eye will have full width
-        *pnWidth = config_.window_width;
-        // Each eye will have half height
-        *pnHeight = config_.window_height / 2;
-        if (eEye == vr::Eye_Left)
-        {
-            // Left eye viewport on the top half of the window
-            *pnY = 0;
-        }
-        else
-        {
-            // Right eye viewport on the bottom half of the window
-            *pnY = config_.window_height / 2;
-        }
-    }
-
-    // Use Side by Side Rendering
-    else
-    {
-        *pnY = 0;
-        // Each eye will have half width
-        *pnWidth = config_.window_width / 2;
-        // Each eye will have full height
-        *pnHeight = config_.window_height;
-        if (eEye == vr::Eye_Left)
-        {
-            // Left eye viewport on the left half of the window
-            *pnX = 0;
-        }
-        else
-        {
-            // Right eye viewport on the right half of the window
-            *pnX = config_.window_width / 2;
-        }
-    }
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Utilize the desired FoV, Aspect Ratio, and Convergence settings
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::GetProjectionRaw( vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom )
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    // Convert horizontal FOV from degrees to radians
-    float horFovRadians = tan((config_.fov * (M_PI / 180.0f)) / 2);
-
-    // Calculate the vertical FOV in radians
-    float verFovRadians = tan(atan(horFovRadians / config_.aspect_ratio));
-
-    // Get convergence value
-    float convergence = GetConvergence();
-
-    // Calculate the raw projection values
-    *pfTop = -verFovRadians;
-    *pfBottom = verFovRadians;
-
-    // Adjust the frustum based on the eye
-    if (eEye == vr::Eye_Left) {
-        *pfLeft = -horFovRadians + convergence;
-        *pfRight = horFovRadians + convergence;
-    }
-    else {
-        *pfLeft = -horFovRadians - convergence;
-        *pfRight = horFovRadians - convergence;
-    }
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: Don't distort any coordinates for Stereo3D
-//-----------------------------------------------------------------------------
-vr::DistortionCoordinates_t StereoDisplayComponent::ComputeDistortion( vr::EVREye eEye, float fU, float fV )
-{
-    vr::DistortionCoordinates_t coordinates{};
-    coordinates.rfBlue[ 0 ] = fU;
-    coordinates.rfBlue[ 1 ] = fV;
-    coordinates.rfGreen[ 0 ] = fU;
-    coordinates.rfGreen[ 1 ] = fV;
-    coordinates.rfRed[ 0 ] = fU;
-    coordinates.rfRed[ 1 ] = fV;
-    return coordinates;
-}
-bool StereoDisplayComponent::ComputeInverseDistortion(vr::HmdVector2_t* pResult, vr::EVREye eEye, uint32_t unChannel, float fU, float fV)
-{
-    return false;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: To inform vrcompositor what the window bounds for this virtual HMD are.
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::GetWindowBounds( int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight )
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    *pnX = config_.window_x;
-    *pnY = config_.window_y;
-    *pnWidth = config_.window_width;
-    *pnHeight = config_.window_height;
-}
-
-//-----------------------------------------------------------------------------
-// Purpose: To provide access to settings
-//-----------------------------------------------------------------------------
-StereoDisplayDriverConfiguration StereoDisplayComponent::GetConfig()
-{
-    std::shared_lock<std::shared_mutex> lock(cfg_mutex_);
-    return config_;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: To update the Depth value
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::AdjustDepth(float new_depth, bool is_delta, uint32_t device_index)
-{
-    float cur_depth = GetDepth();
-    if (is_delta)
-        new_depth += cur_depth;
-    while (!depth_.compare_exchange_weak(cur_depth, new_depth, std::memory_order_relaxed));
-    vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer(device_index);
-    vr::VRProperties()->SetFloatProperty(container, vr::Prop_UserIpdMeters_Float, new_depth);
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: To update the Convergence value
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::AdjustConvergence(float new_conv, bool is_delta, uint32_t device_index)
-{
-    float cur_conv = GetConvergence();
-    if (is_delta)
-        new_conv += cur_conv;
-    if (cur_conv == new_conv)
-        return;
-    while (!convergence_.compare_exchange_weak(cur_conv, new_conv, std::memory_order_relaxed));
-    // Regenerate the Projection
-    vr::HmdRect2_t eyeLeft, eyeRight;
-    GetProjectionRaw(vr::Eye_Left, &eyeLeft.vTopLeft.v[0], &eyeLeft.vBottomRight.v[0], &eyeLeft.vTopLeft.v[1], &eyeLeft.vBottomRight.v[1]);
-    GetProjectionRaw(vr::Eye_Right, &eyeRight.vTopLeft.v[0], &eyeRight.vBottomRight.v[0], &eyeRight.vTopLeft.v[1], &eyeRight.vBottomRight.v[1]);
-    vr::VREvent_Data_t temp;
-    vr::VRServerDriverHost()->SetDisplayProjectionRaw(device_index, eyeLeft, eyeRight);
-    vr::VRServerDriverHost()->VendorSpecificEvent(device_index, vr::VREvent_LensDistortionChanged, temp, 0.0f);
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Get Depth value
-//-----------------------------------------------------------------------------
-float StereoDisplayComponent::GetDepth()
-{
-    return depth_.load(std::memory_order_relaxed);
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Get Convergence value
-//-----------------------------------------------------------------------------
-float StereoDisplayComponent::GetConvergence()
-{
-    return convergence_.load(std::memory_order_relaxed);
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Check User Settings and act on them
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::CheckUserSettings(uint32_t device_index)
-{
-    static int sleep_ctrl = 0;
-    static int sleep_rest = 0;
-    
-    // Get the state of the first controller (index 0)
-    XINPUT_STATE state;
-    ZeroMemory(&state, sizeof(XINPUT_STATE));
-    bool got_xinput = (_XInputGetState(0, &state) == ERROR_SUCCESS);
-
-    DWORD xstate = 0x00000000;
-    xstate = state.Gamepad.wButtons;
-    if (state.Gamepad.bLeftTrigger > XINPUT_GAMEPAD_TRIGGER_THRESHOLD) {
-        xstate |= XINPUT_GAMEPAD_LEFT_TRIGGER;
-    }
-    if (state.Gamepad.bRightTrigger > XINPUT_GAMEPAD_TRIGGER_THRESHOLD) {
-        xstate |= XINPUT_GAMEPAD_RIGHT_TRIGGER;
-    }
-
-    auto config = GetConfig();
-
-    // Toggle Pitch and Yaw control
-    if ((config.ctrl_xinput && got_xinput &&
-        ((xstate & config.ctrl_toggle_key) == config.ctrl_toggle_key))
-        || (!config.ctrl_xinput && (GetAsyncKeyState(config.ctrl_toggle_key) & 0x8000)))
-    {
-        if (config.ctrl_type == HOLD && !config.ctrl_held)
-        {
-            config.ctrl_held = true;
-            config.pitch_enable = false;
-            config.yaw_enable = false;
-        }
-        else if ((config.ctrl_type == TOGGLE || config.ctrl_type == SWITCH) && sleep_ctrl < 1)
-        {
-            sleep_ctrl = config.sleep_count_max;
-            if (config.pitch_set) {
-                config.pitch_enable = !config.pitch_enable;
-            }
-            if (config.yaw_set) {
-                config.yaw_enable = !config.yaw_enable;
-            }
-        }
-    }
-    else if (config.ctrl_type == HOLD && config.ctrl_held)
-    {
-        config.ctrl_held = false;
-        config.pitch_enable = config.pitch_set;
-        config.yaw_enable = config.yaw_set;
-    }
-    if (sleep_ctrl > 0) {
-        sleep_ctrl--;
-    }
-
-    // Reset HMD position
-    if (((config.reset_xinput && got_xinput &&
-        ((xstate & config.pose_reset_key) == config.pose_reset_key))
-        || (!config.reset_xinput && (GetAsyncKeyState(config.pose_reset_key) & 0x8000)))
-        && sleep_rest == 0)
-    {
-        sleep_rest = config.sleep_count_max;
-        if (!config.pose_reset) {
-            config.pose_reset = true;
-        }
-    }
-    else if (sleep_rest > 0) {
-        sleep_rest--;
-    }
-
-    for (int i = 0; i < config.num_user_settings; i++)
-    {
-        // Decrement the sleep count if it's greater than zero
-        if (config.sleep_count[i] > 0)
-            config.sleep_count[i]--;
-
-        // Load stored depth & convergence
-        if ((config.load_xinput[i] && got_xinput &&
-            ((xstate & config.user_load_key[i]) == config.user_load_key[i]))
-            || (!config.load_xinput[i] && (GetAsyncKeyState(config.user_load_key[i]) & 0x8000)))
-        {
-            if (config.user_key_type[i] == HOLD && !config.was_held[i])
-            {
-                config.prev_depth[i] = GetDepth();
-                config.prev_convergence[i] = GetConvergence();
-                config.was_held[i] = true;
-                AdjustDepth(config.user_depth[i], false, device_index);
-                AdjustConvergence(config.user_convergence[i], false, device_index);
-            }
-            else if (config.user_key_type[i] == TOGGLE && config.sleep_count[i] < 1)
-            {
-                config.sleep_count[i] = config.sleep_count_max;
-                if (GetDepth() == config.user_depth[i] && GetConvergence() == config.user_convergence[i])
-                {
-                    // If the current state matches the user settings, revert to the previous state
-                    AdjustDepth(config.prev_depth[i], false, device_index);
-                    AdjustConvergence(config.prev_convergence[i], false, device_index);
-                }
-                else
-                {
-                    // Save the current state and apply the user settings
-                    config.prev_depth[i] = GetDepth();
-                    config.prev_convergence[i] = GetConvergence();
-                    AdjustDepth(config.user_depth[i], false, device_index);
-                    AdjustConvergence(config.user_convergence[i], false, device_index);
-                }
-            }
-            else if (config.user_key_type[i] == SWITCH)
-            {
-                AdjustDepth(config.user_depth[i], false, device_index);
-                AdjustConvergence(config.user_convergence[i], false, device_index);
-            }
-        }
-        // Release depth & convergence back to normal for HOLD key type
-        else if (config.user_key_type[i] == HOLD && config.was_held[i])
-        {
-            config.was_held[i] = false;
-            AdjustDepth(config.prev_depth[i], false, device_index);
-            AdjustConvergence(config.prev_convergence[i], false, device_index);
-        }
-
-        // Store current depth & convergence to user setting
-        if ((GetAsyncKeyState(config.user_store_key[i]) & 0x8000))
-        {
-            config.user_depth[i] = GetDepth();
-            config.user_convergence[i] = GetConvergence();
-        }
-    }
-
-    // Update the config
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    config_ = config;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Adjust XInput Right Stick sensitivity
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::AdjustSensitivity(float delta)
-{
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    if (config_.pitch_enable || config_.yaw_enable)
-    {
-        config_.ctrl_sensitivity += delta;
-        if (config_.ctrl_sensitivity < 0.0f)
-            config_.ctrl_sensitivity = 0.0f;
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Adjust XInput Pitch Radius
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::AdjustRadius(float delta)
-{
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    if (config_.pitch_enable)
-    {
-        config_.pitch_radius += delta;
-        if (config_.pitch_radius < 0.0f)
-            config_.pitch_radius = 0.0f;
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Toggle HMD Height for games that have incorrect HMD position
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::SetHeight()
-{
-    static float user_height = config_.hmd_height;
-
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    if (config_.hmd_height == user_height)
-        config_.hmd_height = 0.1f;
-    else
-        config_.hmd_height = user_height;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Toggle Reset off
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::SetReset()
-{
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    config_.pose_reset = false;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Load Game Specific Settings from Documents\My games\vrto3d\app_name_config.json
-//-----------------------------------------------------------------------------
-void StereoDisplayComponent::LoadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index)
-{
-    // Apply loaded settings
-    AdjustDepth(config.depth, false, device_index);
-    AdjustConvergence(config.convergence, false, device_index);
-    
-    std::unique_lock<std::shared_mutex> lock(cfg_mutex_);
-    config_ = config;
-}
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "hmd_device_driver.h"
+#include "frame_pacer.h"
+#include "key_mappings.h"
+#include "pose_prediction.h"
+#include "pose_kernel.h"
+#include "pose_submit_gate.h"
+#include "pose_derivatives.h"
+#include "notify_sinks.h"
+#include "xinput_backend.h"
+#include "driverlog.h"
+#include "vrmath.h"
+
+#include <string>
+#include <chrono>
+#include <ctime>
+
+#include <windows.h>
+#include <nlohmann/json.hpp>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Fixed Ctrl hotkeys, compiled once into a bind table
+//-----------------------------------------------------------------------------
+enum HotkeyAction
+{
+    HOTKEY_DEPTH_DOWN,
+    HOTKEY_DEPTH_UP,
+    HOTKEY_CONV_DOWN,
+    HOTKEY_CONV_UP,
+    HOTKEY_SAVE_PROFILE,
+    HOTKEY_TOGGLE_TOP,
+    HOTKEY_TOGGLE_HEIGHT,
+    HOTKEY_RELOAD_PROFILE,
+    HOTKEY_SENS_DOWN,
+    HOTKEY_SENS_UP,
+    HOTKEY_RADIUS_DOWN,
+    HOTKEY_RADIUS_UP,
+    HOTKEY_COUNT
+};
+static const KeyBinding hotkey_binds[HOTKEY_COUNT] = {
+    MakeKeyChord({ VK_CONTROL, VK_F3 }),
+    MakeKeyChord({ VK_CONTROL, VK_F4 }),
+    MakeKeyChord({ VK_CONTROL, VK_F5 }),
+    MakeKeyChord({ VK_CONTROL, VK_F6 }),
+    MakeKeyChord({ VK_CONTROL, VK_F7 }),
+    MakeKeyChord({ VK_CONTROL, VK_F8 }),
+    MakeKeyChord({ VK_CONTROL, VK_F9 }),
+    MakeKeyChord({ VK_CONTROL, VK_F10 }),
+    MakeKeyChord({ VK_CONTROL, VK_OEM_MINUS }),
+    MakeKeyChord({ VK_CONTROL, VK_OEM_PLUS }),
+    MakeKeyChord({ VK_CONTROL, VK_OEM_4 }),
+    MakeKeyChord({ VK_CONTROL, VK_OEM_6 }),
+};
+
+
+// Load settings from default.vrsettings
+static const char *stereo_main_settings_section = "driver_vrto3d";
+
+// SteamVR settings forced on every Activate()
+struct BoolSetting
+{
+    const char *section;
+    const char *key;
+    bool value;
+};
+
+static const BoolSetting steamvr_bool_settings[] = {
+    { vr::k_pch_CollisionBounds_Section, vr::k_pch_CollisionBounds_GroundPerimeterOn_Bool, false },
+    { vr::k_pch_DirectMode_Section, vr::k_pch_DirectMode_Enable_Bool, false },
+    { vr::k_pch_Power_Section, vr::k_pch_Power_PauseCompositorOnStandby_Bool, false },
+    { vr::k_pch_Dashboard_Section, vr::k_pch_Dashboard_EnableDashboard_Bool, false },
+    { vr::k_pch_Dashboard_Section, vr::k_pch_Dashboard_ArcadeMode_Bool, true },
+    { vr::k_pch_Dashboard_Section, "allowAppQuitting", false },
+    { vr::k_pch_Dashboard_Section, "autoShowGameTheater", false },
+    { vr::k_pch_Dashboard_Section, "showDesktop", false },
+    { vr::k_pch_Dashboard_Section, "showPowerOptions", false },
+    { vr::k_pch_Dashboard_Section, "inputCaptureEnabled", false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_EnableHomeApp, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_MirrorViewVisibility_Bool, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_EnableSafeMode, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_DisplayDebug_Bool, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_MotionSmoothing_Bool, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_DisableAsyncReprojection_Bool, true },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_AllowSupersampleFiltering_Bool, false },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_SupersampleManualOverride_Bool, true },
+    { vr::k_pch_SteamVR_Section, vr::k_pch_SteamVR_ForceFadeOnBadTracking_Bool, false },
+};
+
+// Chaperone JSON, the universe timestamp goes between head & tail
+static const char chaperone_json_head[] = R"(
+        {
+           "jsonid" : "chaperone_info",
+           "universes" : [
+              {
+                 "collision_bounds" : [
+                    [
+                       [ -1.0, 0.0, -1.0 ],
+                       [ -1.0, 3.0, -1.0 ],
+                       [ -1.0, 3.0, 1.0 ],
+                       [ -1.0, 0.0, 1.0 ]
+                    ],
+                    [
+                       [ -1.0, 0.0, 1.0 ],
+                       [ -1.0, 3.0, 1.0 ],
+                       [ 1.0, 3.0, 1.0 ],
+                       [ 1.0, 0.0, 1.0 ]
+                    ],
+                    [
+                       [ 1.0, 0.0, 1.0 ],
+                       [ 1.0, 3.0, 1.0 ],
+                       [ 1.0, 3.0, -1.0 ],
+                       [ 1.0, 0.0, -1.0 ]
+                    ],
+                    [
+                       [ 1.0, 0.0, -1.0 ],
+                       [ 1.0, 3.0, -1.0 ],
+                       [ -1.0, 3.0, -1.0 ],
+                       [ -1.0, 0.0, -1.0 ]
+                    ]
+                 ],
+                 "play_area" : [ 2.0, 2.0 ],
+                 "seated" : {
+                    "translation" : [ 0.0, 0.5, 0.0 ],
+                    "yaw" : 0.0
+                 },
+                 "standing" : {
+                    "translation" : [ 0.0, 1.0, 0.0 ],
+                    "yaw" : 0.0
+                 },
+                 "time" : ")";
+static const char chaperone_json_tail[] = R"(",
+                 "universeID" : "64"
+              }
+           ],
+           "version" : 5
+        }
+        )";
+
+MockControllerDeviceDriver::MockControllerDeviceDriver()
+    : profile_writer_( json_manager_ )
+{
+    // Keep track of whether Activate() has been called
+    is_active_ = false;
+    curr_pose_.Store({ 0 });
+    app_name_ = "";
+    profile_file_ = DEF_CFG;
+
+    auto* vrs = vr::VRSettings();
+    json_manager_.EnsureDefaultConfigExists();
+
+    char model_number[ 1024 ];
+    vrs->GetString( stereo_main_settings_section, "model_number", model_number, sizeof( model_number ) );
+    stereo_model_number_ = model_number;
+    char serial_number[ 1024 ];
+    vrs->GetString( stereo_main_settings_section, "serial_number", serial_number, sizeof( serial_number ) );
+    stereo_serial_number_ = serial_number;
+
+    DriverLog( "VRto3D Model Number: %s", stereo_model_number_.c_str() );
+    DriverLog( "VRto3D Serial Number: %s", stereo_serial_number_.c_str() );
+
+    gamepad_poller_ = std::make_unique< GamepadPoller >(CreateXInputBackend());
+
+    // Display settings
+    StereoDisplayDriverConfiguration display_configuration{};
+    display_configuration.window_x = 0;
+    display_configuration.window_y = 0;
+    json_manager_.LoadParamsFromJson(display_configuration);
+
+    // Profile settings, built-in defaults if default_config.json doesn't parse
+    if (!json_manager_.LoadProfileFromJson(DEF_CFG, display_configuration))
+        json_manager_.ResetProfile(display_configuration);
+
+    // Instantiate our display component
+    stereo_display_component_ = std::make_unique< StereoDisplayComponent >( display_configuration );
+
+    // Cues play on the notifier thread, never on vrserver's or the hotkey thread
+    notifier_.AddSink(std::make_unique< LogSink >());
+    if (display_configuration.notify_tone)
+        notifier_.AddSink(std::make_unique< ToneSink >());
+    if (display_configuration.notify_rumble)
+        notifier_.AddSink(std::make_unique< XInputRumbleSink >());
+    notifier_.Start();
+
+    DriverLog("Default Config Loaded\n");
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Initialize all settings and notify SteamVR
+//-----------------------------------------------------------------------------
+vr::EVRInitError MockControllerDeviceDriver::Activate( uint32_t unObjectId )
+{
+    device_index_ = unObjectId;
+    is_active_ = true;
+    is_on_top_ = false;
+
+    auto activate_start = std::chrono::steady_clock::now();
+
+    // A list of properties available is contained in vr::ETrackedDeviceProperty.
+    // They all go to vrserver in one batch
+    auto config = stereo_display_component_->GetConfig();
+    vr::PropertyContainerHandle_t container = vr::VRProperties()->TrackedDeviceToPropertyContainer( device_index_ );
+    PropertyBatch props;
+    props.SetString( vr::Prop_ModelNumber_String, stereo_model_number_ );
+    props.SetString( vr::Prop_ManufacturerName_String, "VRto3D" );
+    props.SetString( vr::Prop_TrackingFirmwareVersion_String, "1.0" );
+    props.SetString( vr::Prop_HardwareRevision_String, "1.0" );
+
+    // Display settings
+    props.SetFloat( vr::Prop_UserIpdMeters_Float, config->depth );
+    props.SetFloat( vr::Prop_UserHeadToEyeDepthMeters_Float, 0.f );
+    props.SetFloat( vr::Prop_DisplayFrequency_Float, config->display_frequency * 1.5f );
+    props.SetFloat( vr::Prop_SecondsFromVsyncToPhotons_Float, config->display_latency );
+    props.SetFloat( vr::Prop_SecondsFromPhotonsToVblank_Float, 0.f );
+    props.SetBool( vr::Prop_ReportsTimeSinceVSync_Bool, false );
+    props.SetBool( vr::Prop_IsOnDesktop_Bool, !config->debug_enable );
+    props.SetBool( vr::Prop_DisplayDebugMode_Bool, config->debug_enable );
+    props.SetBool( vr::Prop_HasDriverDirectModeComponent_Bool, false );
+    props.SetFloat( vr::Prop_DashboardScale_Float, config->depth_gauge ? 1.0f : 0.0f );
+
+    // Set the chaperone JSON property, stamped with the current time
+    std::time_t t = std::time(nullptr);
+    std::tm tm;
+    localtime_s(&tm, &t);
+    char chaperone_time[ 64 ];
+    strftime( chaperone_time, sizeof( chaperone_time ), "%a %b %d %H:%M:%S %Y", &tm );
+    std::string chaperone_json;
+    chaperone_json.reserve( sizeof( chaperone_json_head ) + sizeof( chaperone_json_tail ) + sizeof( chaperone_time ) );
+    chaperone_json += chaperone_json_head;
+    chaperone_json += chaperone_time;
+    chaperone_json += chaperone_json_tail;
+    props.SetString( vr::Prop_DriverProvidedChaperoneJson_String, std::move( chaperone_json ) );
+    props.SetUint64( vr::Prop_CurrentUniverseId_Uint64, 64 );
+
+    // Miscellaneous settings
+    props.SetBool( vr::Prop_WillDriftInYaw_Bool, false );
+    props.SetBool( vr::Prop_DeviceIsWireless_Bool, false );
+    props.SetBool( vr::Prop_DeviceIsCharging_Bool, false );
+    props.SetBool( vr::Prop_ContainsProximitySensor_Bool, false );
+    props.SetBool( vr::Prop_DeviceCanPowerOff_Bool, false );
+    uint32_t props_written = props.Write( container );
+
+    // set proximity senser to always on, always head present
+    vr::VRInputComponentHandle_t  prox;
+    vr::VRDriverInput()->CreateBooleanComponent(container, "/proximity", &prox);
+    vr::VRDriverInput()->UpdateBooleanComponent(prox, true, 0.0);
+    
+    // SteamVR settings, only the ones that differ get written
+    uint32_t settings_changed = 0;
+    uint32_t settings_checked = 0;
+    for ( const auto &setting : steamvr_bool_settings )
+    {
+        settings_changed += SyncSetting( setting.section, setting.key, setting.value );
+        settings_checked++;
+    }
+    settings_changed += SyncSetting( vr::k_pch_CollisionBounds_Section, vr::k_pch_CollisionBounds_Style_Int32, ( int32_t )vr::COLLISION_BOUNDS_STYLE_NONE );
+    settings_changed += SyncSetting( vr::k_pch_Power_Section, vr::k_pch_Power_TurnOffScreensTimeout_Float, 86400.0f );
+    settings_checked += 2;
+    
+    // Start every loop from a clean state, also after a re-Activate
+    head_state_ = {};
+    hotkey_state_ = {};
+    focus_state_ = {};
+
+    pose_thread_ = std::thread(&MockControllerDeviceDriver::PoseUpdateThread, this);
+    hotkey_thread_ = std::thread(&MockControllerDeviceDriver::PollHotkeysThread, this);
+    focus_thread_ = std::thread(&MockControllerDeviceDriver::FocusUpdateThread, this);
+    profile_writer_.Start([this](const std::string& file_name, bool saved) {
+        if (saved)
+            notifier_.Post(NOTIFY_SUCCESS);
+    });
+    profile_watcher_.Start(json_manager_.GetFolder(), [this](const std::string& file_name) { OnProfileChanged(file_name); });
+
+    HANDLE thread_handle = pose_thread_.native_handle();
+
+    // Set the thread priority
+    if (!SetThreadPriority(thread_handle, THREAD_PRIORITY_HIGHEST)) {
+        // Handle error if setting priority fails
+        DriverLog("Failed to set thread priority: %d\n", GetLastError());
+    }
+
+    double activate_ms = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - activate_start ).count();
+    DriverLog("Activation Complete in %.2f ms: %u/%zu properties set, %u/%u settings changed\n", activate_ms,
+        props_written, props.Size(), settings_changed, settings_checked);
+
+    return vr::VRInitError_None;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Return StereoDisplayComponent as vr::IVRDisplayComponent
+//-----------------------------------------------------------------------------
+void *MockControllerDeviceDriver::GetComponent( const char *pchComponentNameAndVersion )
+{
+    if ( strcmp( pchComponentNameAndVersion, vr::IVRDisplayComponent_Version ) == 0 )
+    {
+        return stereo_display_component_.get();
+    }
+
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: This is called by vrserver when a debug request has been made from an application to the driver.
+// What is in the response and request is up to the application and driver to figure out themselves.
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::DebugRequest( const char *pchRequest, char *pchResponseBuffer, uint32_t unResponseBufferSize )
+{
+    if ( unResponseBufferSize >= 1 )
+        pchResponseBuffer[ 0 ] = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: True while the controller holds a button or pushes an axis mapped
+// to Depth or Convergence. A connected pad at rest leaves the hotkey thread
+// idle; the pose thread wakes it when the pad starts to move.
+//-----------------------------------------------------------------------------
+static bool PadNeedsPolling(const InputSample& input, const StereoDisplayDriverConfiguration& config)
+{
+    if (!input.connected)
+        return false;
+    if (input.buttons != 0)
+        return true;
+
+    AxisMapping mapping = { config.depth_axis, config.ctrl_deadzone, config.axis_curve, config.axis_rate, config.axis_step };
+    if (AxisMapper::IsDeflected(mapping, input))
+        return true;
+    mapping.axis = config.convergence_axis;
+    return AxisMapper::IsDeflected(mapping, input);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Static Pose with pitch & yaw adjustment
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::PoseUpdateThread()
+{
+    HeadState& head = head_state_;
+
+    // XInput polling limit is 125Hz
+    FramePacer pacer(std::chrono::milliseconds(8));
+    PoseSubmitGate submitGate;
+    const float tickSeconds = std::chrono::duration_cast<std::chrono::duration<float>>(pacer.Period()).count();
+    // Filter over a few ticks, clamp dt to half a tick .. four ticks
+    PoseDerivativeEstimator derivatives(0.025f, 0.5f * tickSeconds, 4.0f * tickSeconds);
+    auto lastTime = FramePacer::Clock::now();
+    bool padWasActive = false;
+    pacer.Start();
+
+    while (is_active_)
+    {
+        auto currentTime = FramePacer::Clock::now();
+        auto deltaTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTime - lastTime).count();
+        lastTime = currentTime;
+
+        // Sample the controller once for every consumer this tick
+        InputSample input = SampleInput();
+        bool got_xinput = input.connected;
+
+        auto config = stereo_display_component_->GetConfig();
+
+        // Wake the hotkey thread as the controller leaves rest, it doesn't poll an idle pad
+        bool padActive = PadNeedsPolling(input, *config);
+        if (padActive && !padWasActive)
+            key_events_.Wake();
+        padWasActive = padActive;
+
+        vr::DriverPose_t pose = { 0 };
+
+        pose.qWorldFromDriverRotation = HmdQuaternion_Identity;
+        pose.qDriverFromHeadRotation = HmdQuaternion_Identity;
+        pose.qRotation = HmdQuaternion_Identity;
+
+        // Stick driven angular rates in degrees per second
+        double pitchRate = 0.0;
+        double yawRate = 0.0;
+
+        // Adjust pitch based on controller input
+        if (config->pitch_enable && got_xinput)
+        {
+            float normalizedY = input.pad.thumb_ry / 32767.0f;
+
+            // Apply deadzone
+            if (std::abs(normalizedY) < config->ctrl_deadzone)
+            {
+                normalizedY = 0.0f;
+            }
+            else
+            {
+                if (normalizedY > 0)
+                    normalizedY = (normalizedY - config->ctrl_deadzone) / (1.0f - config->ctrl_deadzone);
+                else
+                    normalizedY = (normalizedY + config->ctrl_deadzone) / (1.0f - config->ctrl_deadzone);
+            }
+
+            // Scale Pitch
+            float previousPitch = head.pitch;
+            head.pitch += (normalizedY * config->ctrl_sensitivity);
+            if (head.pitch > 90.0f) head.pitch = 90.0f;
+            if (head.pitch < -90.0f) head.pitch = -90.0f;
+            // Rate after clamping, so a pinned pitch doesn't report motion
+            pitchRate = (head.pitch - previousPitch) / tickSeconds;
+        }
+
+        // Adjust yaw based on controller input
+        if (config->yaw_enable && got_xinput)
+        {
+            float normalizedX = input.pad.thumb_rx / 32767.0f;
+
+            // Apply deadzone
+            if (std::abs(normalizedX) < config->ctrl_deadzone)
+            {
+                normalizedX = 0.0f;
+            }
+            else
+            {
+                if (normalizedX > 0)
+                    normalizedX = (normalizedX - config->ctrl_deadzone) / (1.0f - config->ctrl_deadzone);
+                else
+                    normalizedX = (normalizedX + config->ctrl_deadzone) / (1.0f - config->ctrl_deadzone);
+            }
+
+            // Scale Yaw
+            float yawAdjustment = -normalizedX * config->ctrl_sensitivity;
+            yawRate = yawAdjustment / tickSeconds;
+            head.yaw = WrapDegrees(head.yaw + yawAdjustment);
+        }
+
+        // Reset Pose to origin
+        if (config->pose_reset)
+        {
+            head.pitch = 0.0f;
+            head.yaw = 0.0;
+            pitchRate = 0.0;
+            yawRate = 0.0;
+            derivatives.Reset();
+            stereo_display_component_->SetReset();
+        }
+
+        // Extrapolate pitch & yaw to the expected photon time, the accumulated state is left untouched
+        double predictedPitch = head.pitch + PredictAngleOffset(config->pose_prediction, pitchRate, config->display_latency, config->prediction_damping);
+        if (predictedPitch > 90.0) predictedPitch = 90.0;
+        if (predictedPitch < -90.0) predictedPitch = -90.0;
+        double predictedYaw = WrapDegrees(head.yaw + PredictAngleOffset(config->pose_prediction, yawRate, config->display_latency, config->prediction_damping));
+
+        double pitchRadians = DEG_TO_RAD(predictedPitch);
+        double yawRadians = DEG_TO_RAD(predictedYaw);
+
+        // Rotation and orbit position relative to the current pitch & yaw
+        ComputeHeadPose(pitchRadians, yawRadians, config->pitch_radius, config->hmd_height, pose.qRotation, pose.vecPosition);
+        if (pose.vecPosition[1] < 0.0)
+        {
+            pose.vecPosition[1] = 0.0;
+        }
+
+        // Velocity & acceleration, angular terms come straight from the stick rates
+        derivatives.Update(pose, deltaTime, DEG_TO_RAD(pitchRate), DEG_TO_RAD(yawRate));
+
+        pose.poseIsValid = true;
+        pose.deviceIsConnected = true;
+        pose.result = vr::TrackingResult_Running_OK;
+        pose.shouldApplyHeadModel = false;
+        pose.willDriftInYaw = false;
+        // The pose is display_latency ahead of now when prediction is on. Telling
+        // vrserver so keeps it from extrapolating that stretch again with the
+        // velocities above, it only predicts whatever is left to photon time
+        pose.poseTimeOffset = config->pose_prediction != PREDICT_NONE ? config->display_latency : 0.0;
+
+        // Publish the pose for GetPose() readers
+        curr_pose_.Store(pose);
+
+        // Skip the IPC if vrserver already has this exact pose
+        if (submitGate.ShouldSubmit(pose, currentTime, config->pose_keepalive_rate))
+        {
+            vr::VRServerDriverHost()->TrackedDevicePoseUpdated(device_index_, pose, sizeof(vr::DriverPose_t));
+        }
+
+        // Sleep until the next tick deadline
+        pacer.Wait();
+    }
+
+    pacer.LogStats("Pose thread");
+    submitGate.LogStats("Pose thread");
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Poll all XInput slots and publish the timestamped sample to the input bus
+//-----------------------------------------------------------------------------
+InputSample MockControllerDeviceDriver::SampleInput()
+{
+    auto now = GamepadPoller::Clock::now();
+    GamepadState pad;
+    bool connected = gamepad_poller_->Poll(now, pad);
+
+    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch());
+    return input_bus_.Publish(pad, connected, timestamp.count());
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Return current pose
+//-----------------------------------------------------------------------------
+vr::DriverPose_t MockControllerDeviceDriver::GetPose()
+{
+    return curr_pose_.Load();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Update HMD position, Depth, Convergence, and user binds
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::PollHotkeysThread()
+{
+    const int sleep_time = (int)(floor(1000.0 / stereo_display_component_->GetConfig()->display_frequency));
+    HotkeyState& hotkeys = hotkey_state_;
+    uint64_t input_cursor = 0;
+
+    KeySet hotkey_keys;
+    for (const auto& bind : hotkey_binds)
+        hotkey_keys |= bind.keys;
+
+    KeySnapshot keys;
+    auto held = [&](HotkeyAction action) { return keys.IsHeld(hotkey_binds[action]); };
+    // A step on the press, then one per auto-repeat while the bind stays held
+    auto step = [&](BindingState& bind, HotkeyAction action) { return (bind.Update(held(action), keys.Time()) & (BIND_PRESS | BIND_REPEAT)) != 0; };
+
+    // The keyboard hook doesn't see mouse buttons, binds on those need polling
+    KeySet mouse_keys;
+    for (int key : { VK_LBUTTON, VK_RBUTTON, VK_MBUTTON, VK_XBUTTON1, VK_XBUTTON2 })
+        mouse_keys.set(key);
+
+    // Fall back to polling every frame if no key events are available
+    key_events_.Start();
+
+    while (is_active_)
+    {
+        // One read of every bound key and everything sampled from the controller since the last pass
+        keys.Capture(hotkey_keys | stereo_display_component_->GetConfig()->bound_keys, input_bus_.Collect(input_cursor), KeySnapshot::Clock::now());
+        // Catch a keyboard hook Windows has dropped, the poll sees keys it no longer reports
+        key_events_.CheckHook(keys.Down(), (hotkey_keys | stereo_display_component_->GetConfig()->bound_keys) & ~mouse_keys, keys.Time());
+
+        if (!stereo_display_component_->GetConfig()->disable_hotkeys) {
+            auto config = stereo_display_component_->GetConfig();
+
+            // Ctrl+F3 Decrease Depth, Ctrl+F4 Increase Depth
+            int depth_dir = held(HOTKEY_DEPTH_DOWN) ? -1 : held(HOTKEY_DEPTH_UP) ? 1 : 0;
+            float depth_delta = hotkeys.depth_ramp.Step(depth_dir, keys.Time(), config->adjust_rate, config->adjust_accel);
+            if (depth_delta != 0.0f) {
+                stereo_display_component_->AdjustDepth(depth_delta, true, device_index_);
+            }
+            // Ctrl+F5 Decrease Convergence, Ctrl+F6 Increase Convergence
+            int conv_dir = held(HOTKEY_CONV_DOWN) ? -1 : held(HOTKEY_CONV_UP) ? 1 : 0;
+            float conv_delta = hotkeys.convergence_ramp.Step(conv_dir, keys.Time(), config->adjust_rate, config->adjust_accel);
+            if (conv_delta != 0.0f) {
+                stereo_display_component_->AdjustConvergence(conv_delta, true, device_index_);
+            }
+            // Ctrl+F7 Store settings into game profile
+            uint32_t save = hotkeys.save_profile.Update(held(HOTKEY_SAVE_PROFILE), keys.Time());
+            uint32_t reload = hotkeys.reload_profile.Update(held(HOTKEY_RELOAD_PROFILE), keys.Time());
+            if (save & BIND_PRESS) {
+                std::lock_guard<std::mutex> lock(profile_mutex_);
+                auto config = *stereo_display_component_->GetConfig();
+                config.depth = stereo_display_component_->GetDepth();
+                config.convergence = stereo_display_component_->GetConvergence();
+                profile_file_ = app_name_ + "_config.json";
+                // Success is signalled once the writer has the file on disk
+                profile_writer_.Queue(profile_file_, config);
+            }
+            // Ctrl+F10 Reload settings from default.vrsettings
+            else if (reload & BIND_PRESS) {
+                std::lock_guard<std::mutex> lock(profile_mutex_);
+                auto config = *stereo_display_component_->GetConfig();
+                if (json_manager_.LoadProfileFromJson(DEF_CFG, config))
+                {
+                    profile_file_ = DEF_CFG;
+                    stereo_display_component_->LoadSettings(config, device_index_);
+                    DriverLog("Loaded %s profile\n", DEF_CFG.c_str());
+                    notifier_.Post(NOTIFY_SUCCESS);
+                }
+            }
+        }
+        // Ctrl+F8 Toggle Always On Top
+        if (hotkeys.toggle_top.Update(held(HOTKEY_TOGGLE_TOP), keys.Time()) & BIND_PRESS) {
+            is_on_top_ = !is_on_top_;
+        }
+        // Ctrl+F9 Toggle HMD height
+        if (hotkeys.toggle_height.Update(held(HOTKEY_TOGGLE_HEIGHT), keys.Time()) & BIND_PRESS) {
+            stereo_display_component_->SetHeight();
+        }
+        // Ctrl+- Decrease Sensitivity
+        if (step(hotkeys.sens_down, HOTKEY_SENS_DOWN)) {
+            stereo_display_component_->AdjustSensitivity(-0.01f);
+        }
+        // Ctrl++ Increase Sensitivity
+        if (step(hotkeys.sens_up, HOTKEY_SENS_UP)) {
+            stereo_display_component_->AdjustSensitivity(0.01f);
+        }
+        // Ctrl+[ Decrease Pitch Radius
+        if (step(hotkeys.radius_down, HOTKEY_RADIUS_DOWN)) {
+            stereo_display_component_->AdjustRadius(-0.01f);
+        }
+        // Ctrl+] Increase Pitch Radius
+        if (step(hotkeys.radius_up, HOTKEY_RADIUS_UP)) {
+            stereo_display_component_->AdjustRadius(0.01f);
+        }
+
+        // Controller axes mapped to Depth & Convergence, only updated when the quantized value moves
+        {
+            auto config = stereo_display_component_->GetConfig();
+            AxisMapping mapping = { config->depth_axis, config->ctrl_deadzone, config->axis_curve, config->axis_rate, config->axis_step };
+            float value;
+            if (hotkeys.depth_axis.Update(mapping, keys.Input(), keys.Time(), stereo_display_component_->GetDepth(), value)) {
+                stereo_display_component_->AdjustDepth(value, false, device_index_);
+            }
+            mapping.axis = config->convergence_axis;
+            if (hotkeys.convergence_axis.Update(mapping, keys.Input(), keys.Time(), stereo_display_component_->GetConvergence(), value)) {
+                stereo_display_component_->AdjustConvergence(value, false, device_index_);
+            }
+        }
+
+        // Check User binds against the same snapshot
+        stereo_display_component_->CheckUserSettings(device_index_, keys);
+
+        // Send any depth & convergence change from this pass in one go
+        stereo_display_component_->CommitChanges(device_index_);
+
+        // Nothing held and the controller at rest: block until a key goes down
+        // or the pose thread sees the pad move, still polling once a second
+        // for CheckHook(). Otherwise keep ticking ~ 1 frame for held keys &
+        // controller binds, waking early on presses
+        auto config = stereo_display_component_->GetConfig();
+        bool idle = key_events_.IsRunning() && !keys.AnyDown() && !PadNeedsPolling(keys.Input(), *config) &&
+            (config->bound_keys & mouse_keys).none();
+        key_events_.WaitForTransition(std::chrono::milliseconds(idle ? 1000 : sleep_time));
+    }
+
+    key_events_.Stop();
+    stereo_display_component_->LogPropertyStats("Hotkey thread");
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Keep Headset Window on top if set
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::FocusUpdateThread()
+{
+    const int sleep_time = 1000;
+    HWND& vr_window = focus_state_.vr_window;
+
+    while (is_active_)
+    {
+        // Keep VR display always on top for 3D rendering
+        if (is_on_top_) {
+            HWND top_window = GetTopWindow(GetDesktopWindow());
+            if (vr_window != NULL && vr_window != top_window) {
+                SetWindowPos(vr_window, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+            }
+            else if (vr_window == NULL) {
+                vr_window = FindWindow(NULL, L"Headset Window");
+            }
+        }
+        else if (vr_window != NULL) {
+            SetWindowPos(vr_window, HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+            vr_window = NULL;
+        }
+
+        // Sleep for 1s
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load Game Specific Settings from Documents\My games\vrto3d\app_name_config.json
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::LoadSettings(const std::string& app_name)
+{
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    if (app_name != app_name_)
+    {
+        app_name_ = app_name;
+        auto config = *stereo_display_component_->GetConfig();
+
+        // Attempt to read the JSON settings file
+        if (json_manager_.LoadProfileFromJson(app_name + "_config.json", config))
+        {
+            profile_file_ = app_name + "_config.json";
+            stereo_display_component_->LoadSettings(config, device_index_);
+            DriverLog("Loaded %s profile\n", app_name.c_str());
+            notifier_.Post(NOTIFY_SUCCESS);
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Apply an edited profile if it is the one in use, or the running
+// game's own profile. Called on the profile watcher thread.
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::OnProfileChanged(const std::string& file_name)
+{
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    bool is_app_profile = !app_name_.empty() && file_name == app_name_ + "_config.json";
+    if (file_name != profile_file_ && !is_app_profile)
+        return;
+
+    // A game profile takes the settings it leaves out from default_config.json,
+    // so an edit to the defaults re-applies it on top of them
+    std::string reload_file = file_name;
+    if (file_name == DEF_CFG && profile_file_ != DEF_CFG)
+        reload_file = profile_file_;
+
+    auto config = *stereo_display_component_->GetConfig();
+    if (json_manager_.LoadProfileFromJson(reload_file, config))
+    {
+        profile_file_ = reload_file;
+        stereo_display_component_->ReloadSettings(config, device_index_);
+        DriverLog("Reloaded edited %s profile\n", file_name.c_str());
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Stub for Standby mode
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::EnterStandby()
+{
+    DriverLog( "HMD has been put into standby." );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Shutdown process
+//-----------------------------------------------------------------------------
+void MockControllerDeviceDriver::Deactivate()
+{
+    if ( is_active_.exchange( false ) )
+    {
+        key_events_.Wake();
+        pose_thread_.join();
+        hotkey_thread_.join();
+        focus_thread_.join();
+        profile_watcher_.Stop();
+        // Flushes any save still queued from the hotkey thread
+        profile_writer_.Stop();
+        profile_writer_.LogStats("Driver");
+        notifier_.LogStats("Driver");
+    }
+
+    // unassign our controller index (we don't want to be calling vrserver anymore after Deactivate() has been called
+    device_index_ = vr::k_unTrackedDeviceIndexInvalid;
+}
+
+
+//-----------------------------------------------------------------------------
+// DISPLAY DRIVER METHOD DEFINITIONS
+//-----------------------------------------------------------------------------
+
+StereoDisplayComponent::StereoDisplayComponent( const StereoDisplayDriverConfiguration &config )
+    : config_( std::make_shared< const StereoDisplayDriverConfiguration >( config ) ), depth_(config.depth), convergence_(config.convergence), projection_dirty_(false)
+{
+    // vrserver reads the initial frustum through GetProjectionRaw()
+    committed_left_ = ProjectionRect(vr::Eye_Left);
+    committed_right_ = ProjectionRect(vr::Eye_Right);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: To inform vrcompositor if this display is considered an on-desktop display.
+//-----------------------------------------------------------------------------
+bool StereoDisplayComponent::IsDisplayOnDesktop()
+{
+    auto config = GetConfig();
+    return !config->debug_enable;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: To as vrcompositor to search for this display.
+//-----------------------------------------------------------------------------
+bool StereoDisplayComponent::IsDisplayRealDisplay()
+{
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: To inform the rest of the vr system what the recommended target size should be
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight )
+{
+    auto config = GetConfig();
+    *pnWidth = config->render_width;
+    *pnHeight = config->render_height;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Render in SbS or TaB Stereo3D
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::GetEyeOutputViewport( vr::EVREye eEye, uint32_t *pnX, uint32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight )
+{
+    auto config = GetConfig();
+    if (config->reverse_enable)
+    {
+        eEye = static_cast<vr::EVREye>(!static_cast<bool> (eEye));
+    }
+    // Use Top and Bottom Rendering
+    if (config->tab_enable)
+    {
+        *pnX = 0;
+        // Each eye will have full width
+        *pnWidth = config->window_width;
+        // Each eye will have half height
+        *pnHeight = config->window_height / 2;
+        if (eEye == vr::Eye_Left)
+        {
+            // Left eye viewport on the top half of the window
+            *pnY = 0;
+        }
+        else
+        {
+            // Right eye viewport on the bottom half of the window
+            *pnY = config->window_height / 2;
+        }
+    }
+
+    // Use Side by Side Rendering
+    else
+    {
+        *pnY = 0;
+        // Each eye will have half width
+        *pnWidth = config->window_width / 2;
+        // Each eye will have full height
+        *pnHeight = config->window_height;
+        if (eEye == vr::Eye_Left)
+        {
+            // Left eye viewport on the left half of the window
+            *pnX = 0;
+        }
+        else
+        {
+            // Right eye viewport on the right half of the window
+            *pnX = config->window_width / 2;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Utilize the desired FoV, Aspect Ratio, and Convergence settings
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::GetProjectionRaw( vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom )
+{
+    auto config = GetConfig();
+    // Convert horizontal FOV from degrees to radians
+    float horFovRadians = tan((config->fov * (M_PI / 180.0f)) / 2);
+
+    // Calculate the vertical FOV in radians
+    float verFovRadians = tan(atan(horFovRadians / config->aspect_ratio));
+
+    // Get convergence value
+    float convergence = GetConvergence();
+
+    // Calculate the raw projection values
+    *pfTop = -verFovRadians;
+    *pfBottom = verFovRadians;
+
+    // Adjust the frustum based on the eye
+    if (eEye == vr::Eye_Left) {
+        *pfLeft = -horFovRadians + convergence;
+        *pfRight = horFovRadians + convergence;
+    }
+    else {
+        *pfLeft = -horFovRadians - convergence;
+        *pfRight = horFovRadians - convergence;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Don't distort any coordinates for Stereo3D
+//-----------------------------------------------------------------------------
+vr::DistortionCoordinates_t StereoDisplayComponent::ComputeDistortion( vr::EVREye eEye, float fU, float fV )
+{
+    vr::DistortionCoordinates_t coordinates{};
+    coordinates.rfBlue[ 0 ] = fU;
+    coordinates.rfBlue[ 1 ] = fV;
+    coordinates.rfGreen[ 0 ] = fU;
+    coordinates.rfGreen[ 1 ] = fV;
+    coordinates.rfRed[ 0 ] = fU;
+    coordinates.rfRed[ 1 ] = fV;
+    return coordinates;
+}
+bool StereoDisplayComponent::ComputeInverseDistortion(vr::HmdVector2_t* pResult, vr::EVREye eEye, uint32_t unChannel, float fU, float fV)
+{
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: To inform vrcompositor what the window bounds for this virtual HMD are.
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::GetWindowBounds( int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight )
+{
+    auto config = GetConfig();
+    *pnX = config->window_x;
+    *pnY = config->window_y;
+    *pnWidth = config->window_width;
+    *pnHeight = config->window_height;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: To provide access to settings
+//-----------------------------------------------------------------------------
+std::shared_ptr< const StereoDisplayDriverConfiguration > StereoDisplayComponent::GetConfig() const
+{
+    return config_.Load();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Swap in a new settings snapshot, caller must hold cfg_mutex_
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::PublishConfig(std::shared_ptr< const StereoDisplayDriverConfiguration > config)
+{
+    config_.Store(std::move(config));
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: To update the Depth value
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::AdjustDepth(float new_depth, bool is_delta, uint32_t device_index)
+{
+    // A failed exchange reloads cur_depth, so a delta is reapplied to the latest value
+    float cur_depth = GetDepth();
+    float next_depth;
+    do {
+        next_depth = is_delta ? cur_depth + new_depth : new_depth;
+        if (next_depth == cur_depth)
+            return;
+    } while (!depth_.compare_exchange_weak(cur_depth, next_depth, std::memory_order_relaxed));
+    // Sent by the next CommitChanges()
+    properties_.SetFloat(device_index, vr::Prop_UserIpdMeters_Float, next_depth);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: To update the Convergence value
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::AdjustConvergence(float new_conv, bool is_delta, uint32_t device_index)
+{
+    float cur_conv = GetConvergence();
+    float next_conv;
+    do {
+        next_conv = is_delta ? cur_conv + new_conv : new_conv;
+        if (next_conv == cur_conv)
+            return;
+    } while (!convergence_.compare_exchange_weak(cur_conv, next_conv, std::memory_order_relaxed));
+    // The projection is regenerated by the next CommitChanges()
+    projection_dirty_.store(true, std::memory_order_release);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Send queued depth writes and, if convergence moved since the last
+// commit, the projection. Every LensDistortionChanged event makes vrcompositor
+// rebuild its distortion mesh, so this runs at most once per tick and only for
+// a changed frustum.
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::CommitChanges(uint32_t device_index)
+{
+    properties_.Flush();
+
+    if (!projection_dirty_.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    std::unique_lock<std::mutex> lock(projection_mutex_);
+    vr::HmdRect2_t eyeLeft = ProjectionRect(vr::Eye_Left);
+    vr::HmdRect2_t eyeRight = ProjectionRect(vr::Eye_Right);
+    if (memcmp(&eyeLeft, &committed_left_, sizeof(eyeLeft)) == 0 && memcmp(&eyeRight, &committed_right_, sizeof(eyeRight)) == 0)
+        return;
+    committed_left_ = eyeLeft;
+    committed_right_ = eyeRight;
+
+    vr::VREvent_Data_t temp;
+    vr::VRServerDriverHost()->SetDisplayProjectionRaw(device_index, eyeLeft, eyeRight);
+    vr::VRServerDriverHost()->VendorSpecificEvent(device_index, vr::VREvent_LensDistortionChanged, temp, 0.0f);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Log how many property writes were saved
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::LogPropertyStats(const char* name) const
+{
+    properties_.LogStats(name);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: One eye's raw projection as a rect
+//-----------------------------------------------------------------------------
+vr::HmdRect2_t StereoDisplayComponent::ProjectionRect(vr::EVREye eye)
+{
+    vr::HmdRect2_t rect;
+    GetProjectionRaw(eye, &rect.vTopLeft.v[0], &rect.vBottomRight.v[0], &rect.vTopLeft.v[1], &rect.vBottomRight.v[1]);
+    return rect;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Get Depth value
+//-----------------------------------------------------------------------------
+float StereoDisplayComponent::GetDepth()
+{
+    return depth_.load(std::memory_order_relaxed);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Get Convergence value
+//-----------------------------------------------------------------------------
+float StereoDisplayComponent::GetConvergence()
+{
+    return convergence_.load(std::memory_order_relaxed);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Check User Settings and act on them
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::CheckUserSettings(uint32_t device_index, const KeySnapshot& keys)
+{
+    // Copy-on-write: the snapshot is only cloned when something changes
+    std::unique_lock<std::mutex> lock(cfg_mutex_);
+    auto current = GetConfig();
+    std::shared_ptr< StereoDisplayDriverConfiguration > next;
+    const StereoDisplayDriverConfiguration* config = current.get();
+    auto edit = [&]() -> StereoDisplayDriverConfiguration& {
+        if (!next) {
+            next = std::make_shared< StereoDisplayDriverConfiguration >(*current);
+            config = next.get();
+        }
+        return *next;
+    };
+    const auto now = keys.Time();
+
+    // Toggle Pitch and Yaw control
+    uint32_t ctrl = bind_state_.ctrl_toggle.Update(keys.IsHeld(config->ctrl_toggle_bind), now);
+    if (config->ctrl_type == HOLD)
+    {
+        if (bind_state_.ctrl_toggle.IsPressed() && !config->ctrl_held)
+        {
+            edit().ctrl_held = true;
+            edit().pitch_enable = false;
+            edit().yaw_enable = false;
+        }
+        else if (!bind_state_.ctrl_toggle.IsPressed() && config->ctrl_held)
+        {
+            edit().ctrl_held = false;
+            edit().pitch_enable = config->pitch_set;
+            edit().yaw_enable = config->yaw_set;
+        }
+    }
+    else if ((config->ctrl_type == TOGGLE || config->ctrl_type == SWITCH) && (ctrl & BIND_PRESS))
+    {
+        if (config->pitch_set) {
+            edit().pitch_enable = !config->pitch_enable;
+        }
+        if (config->yaw_set) {
+            edit().yaw_enable = !config->yaw_enable;
+        }
+    }
+
+    // Reset HMD position
+    if ((bind_state_.pose_reset.Update(keys.IsHeld(config->pose_reset_bind), now) & BIND_PRESS) && !config->pose_reset)
+    {
+        edit().pose_reset = true;
+    }
+
+    // One press tracker per user setting, resized when a profile changes their number
+    if (bind_state_.user_load.size() != config->num_user_settings)
+        bind_state_.user_load.resize(config->num_user_settings, BindingState(k_bind_debounce));
+
+    for (int i = 0; i < config->num_user_settings; i++)
+    {
+        BindingState& load = bind_state_.user_load[i];
+        uint32_t events = load.Update(keys.IsHeld(config->user_load_bind[i]), now);
+
+        // Load stored depth & convergence while held
+        if (config->user_key_type[i] == HOLD)
+        {
+            if (load.IsPressed() && !config->was_held[i])
+            {
+                edit().prev_depth[i] = GetDepth();
+                edit().prev_convergence[i] = GetConvergence();
+                edit().was_held[i] = true;
+                AdjustDepth(config->user_depth[i], false, device_index);
+                AdjustConvergence(config->user_convergence[i], false, device_index);
+            }
+            // Release depth & convergence back to normal
+            else if (!load.IsPressed() && config->was_held[i])
+            {
+                edit().was_held[i] = false;
+                AdjustDepth(config->prev_depth[i], false, device_index);
+                AdjustConvergence(config->prev_convergence[i], false, device_index);
+            }
+        }
+        else if (config->user_key_type[i] == TOGGLE && (events & BIND_PRESS))
+        {
+            if (GetDepth() == config->user_depth[i] && GetConvergence() == config->user_convergence[i])
+            {
+                // If the current state matches the user settings, revert to the previous state
+                AdjustDepth(config->prev_depth[i], false, device_index);
+                AdjustConvergence(config->prev_convergence[i], false, device_index);
+            }
+            else
+            {
+                // Save the current state and apply the user settings
+                edit().prev_depth[i] = GetDepth();
+                edit().prev_convergence[i] = GetConvergence();
+                AdjustDepth(config->user_depth[i], false, device_index);
+                AdjustConvergence(config->user_convergence[i], false, device_index);
+            }
+        }
+        else if (config->user_key_type[i] == SWITCH && (events & BIND_PRESS))
+        {
+            AdjustDepth(config->user_depth[i], false, device_index);
+            AdjustConvergence(config->user_convergence[i], false, device_index);
+        }
+
+        // Store current depth & convergence to user setting, only publishing if they differ
+        if (keys.IsHeld(config->user_store_bind[i]) &&
+            (config->user_depth[i] != GetDepth() || config->user_convergence[i] != GetConvergence()))
+        {
+            edit().user_depth[i] = GetDepth();
+            edit().user_convergence[i] = GetConvergence();
+        }
+    }
+
+    // Publish the updated config
+    if (next)
+        PublishConfig(next);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Adjust XInput Right Stick sensitivity
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::AdjustSensitivity(float delta)
+{
+    std::unique_lock<std::mutex> lock(cfg_mutex_);
+    auto config = GetConfig();
+    float sensitivity = config->ctrl_sensitivity + delta;
+    if (sensitivity < 0.0f)
+        sensitivity = 0.0f;
+    if ((config->pitch_enable || config->yaw_enable) && sensitivity != config->ctrl_sensitivity)
+    {
+        auto next = std::make_shared< StereoDisplayDriverConfiguration >(*config);
+        next->ctrl_sensitivity = sensitivity;
+        PublishConfig(next);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Adjust XInput Pitch Radius
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::AdjustRadius(float delta)
+{
+    std::unique_lock<std::mutex> lock(cfg_mutex_);
+    auto config = GetConfig();
+    float radius = config->pitch_radius + delta;
+    if (radius < 0.0f)
+        radius = 0.0f;
+    if (config->pitch_enable && radius != config->pitch_radius)
+    {
+        auto next = std::make_shared< StereoDisplayDriverConfiguration >(*config);
+        next->pitch_radius = radius;
+        PublishConfig(next);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Toggle HMD Height for games that have incorrect HMD position
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::SetHeight()
+{
+    std::unique_lock<std::mutex> lock(cfg_mutex_);
+    auto next = std::make_shared< StereoDisplayDriverConfiguration >(*GetConfig());
+    // Remember the height in effect the first time this is toggled
+    if (!user_height_)
+        user_height_ = next->hmd_height;
+    if (next->hmd_height == *user_height_)
+        next->hmd_height = 0.1f;
+    else
+        next->hmd_height = *user_height_;
+    PublishConfig(next);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Toggle Reset off
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::SetReset()
+{
+    std::unique_lock<std::mutex> lock(cfg_mutex_);
+    auto next = std::make_shared< StereoDisplayDriverConfiguration >(*GetConfig());
+    next->pose_reset = false;
+    PublishConfig(next);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load Game Specific Settings from Documents\My games\vrto3d\app_name_config.json
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::LoadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index)
+{
+    // Apply loaded settings
+    AdjustDepth(config.depth, false, device_index);
+    AdjustConvergence(config.convergence, false, device_index);
+    
+    {
+        std::unique_lock<std::mutex> lock(cfg_mutex_);
+        PublishConfig(std::make_shared< const StereoDisplayDriverConfiguration >(config));
+    }
+
+    // Profile loads don't wait for the hotkey thread, which may be idle
+    CommitChanges(device_index);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Apply a re-read profile on top of the running one. Depth and
+// Convergence only move if the file changed them, so live adjustments and
+// toggled pitch/yaw survive an edit of some other field.
+//-----------------------------------------------------------------------------
+void StereoDisplayComponent::ReloadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index)
+{
+    {
+        std::unique_lock<std::mutex> lock(cfg_mutex_);
+        auto previous = GetConfig();
+        if (config.depth != previous->depth)
+            AdjustDepth(config.depth, false, device_index);
+        if (config.convergence != previous->convergence)
+            AdjustConvergence(config.convergence, false, device_index);
+
+        // *_set hold the file's value, *_enable the live toggle
+        config.pose_reset = previous->pose_reset;
+        if (config.pitch_set == previous->pitch_set)
+            config.pitch_enable = previous->pitch_enable;
+        if (config.yaw_set == previous->yaw_set)
+            config.yaw_enable = previous->yaw_enable;
+
+        // Keep the press state of binds held across the reload, so they don't fire again
+        if (config.ctrl_type == HOLD && previous->ctrl_type == HOLD && previous->ctrl_held)
+        {
+            config.ctrl_held = true;
+            config.pitch_enable = false;
+            config.yaw_enable = false;
+        }
+        for (size_t i = 0; i < config.num_user_settings && i < previous->num_user_settings; i++)
+        {
+            config.was_held[i] = previous->was_held[i];
+            config.prev_depth[i] = previous->prev_depth[i];
+            config.prev_convergence[i] = previous->prev_convergence[i];
+        }
+        PublishConfig(std::make_shared< const StereoDisplayDriverConfiguration >(config));
+    }
+
+    CommitChanges(device_index);
+}
@@ -1,103 +1,205 @@
-/*
- * This file is part of VRto3D.
- *
- * VRto3D is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * VRto3D is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
- * GNU Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public License
- * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
- */
-#pragma once
-#include "openvr_driver.h"
-#include <atomic>
-#include <thread>
-#include <shared_mutex>
-#include <string>
-
-#include "json_manager.h"
-
- // Forward declare XINPUT_STATE
-struct _XINPUT_STATE;
-typedef _XINPUT_STATE XINPUT_STATE;
-
-
-class StereoDisplayComponent : public vr::IVRDisplayComponent
-{
-public:
-    explicit StereoDisplayComponent( const StereoDisplayDriverConfiguration &config );
-
-    // ----- Functions to override vr::IVRDisplayComponent -----
-    bool IsDisplayOnDesktop() override;
-    bool IsDisplayRealDisplay() override;
-    void GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight ) override;
-    void GetEyeOutputViewport( vr::EVREye eEye, uint32_t *pnX, uint32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight ) override;
-    void GetProjectionRaw( vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom ) override;
-    vr::DistortionCoordinates_t ComputeDistortion( vr::EVREye eEye, float fU, float fV ) override;
-    bool ComputeInverseDistortion(vr::HmdVector2_t* pResult, vr::EVREye eEye, uint32_t unChannel, float fU, float fV) override;
-    void GetWindowBounds( int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight ) override;
-    StereoDisplayDriverConfiguration GetConfig();
-    void AdjustDepth(float new_depth, bool is_delta, uint32_t device_index);
-    void AdjustConvergence(float new_conv, bool is_delta, uint32_t device_index);
-    float GetDepth();
-    float GetConvergence();
-    void CheckUserSettings(uint32_t device_index);
-    void AdjustSensitivity(float delta);
-    void AdjustRadius(float delta);
-    void SetHeight();
-    void SetReset();
-    void LoadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index);
-
-private:
-    StereoDisplayDriverConfiguration config_;
-    std::atomic< float > depth_;
-    std::atomic< float > convergence_;
-
-    std::shared_mutex  cfg_mutex_;
-};
-
-//-----------------------------------------------------------------------------
-// Purpose: Represents a Mock HMD in the system
-//-----------------------------------------------------------------------------
-class MockControllerDeviceDriver : public vr::ITrackedDeviceServerDriver
-{
-public:
-    MockControllerDeviceDriver();
-    vr::EVRInitError Activate( uint32_t unObjectId ) override;
-    void EnterStandby() override;
-    void *GetComponent( const char *pchComponentNameAndVersion ) override;
-    void DebugRequest( const char *pchRequest, char *pchResponseBuffer, uint32_t unResponseBufferSize ) override;
-    vr::DriverPose_t GetPose() override;
-    void Deactivate() override;
-
-    void PoseUpdateThread();
-    void PollHotkeysThread();
-    void FocusUpdateThread();
-
-    void LoadSettings(const std::string& app_name);
-
-private:
-    std::unique_ptr< StereoDisplayComponent > stereo_display_component_;
-
-    std::string stereo_model_number_;
-    std::string stereo_serial_number_;
-
-    std::string app_name_;
-
-    std::atomic< bool > is_active_;
-    std::atomic< uint32_t > device_index_;
-    std::atomic< bool > is_on_top_;
-
-    std::mutex pose_mutex_;
-    vr::DriverPose_t curr_pose_;
-
-    std::thread pose_thread_;
-    std::thread hotkey_thread_;
-    std::thread focus_thread_;
-};
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "openvr_driver.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "adjust_ramp.h"
+#include "axis_mapping.h"
+#include "binding_state.h"
+#include "gamepad_poller.h"
+#include "input_bus.h"
+#include "json_manager.h"
+#include "key_bindings.h"
+#include "key_events.h"
+#include "notifier.h"
+#include "profile_watcher.h"
+#include "profile_writer.h"
+#include "property_writer.h"
+#include "seqlock.h"
+#include "snapshot_slot.h"
+
+// Opaque window handle, matches the STRICT HWND from windows.h
+struct HWND__;
+
+
+// Shortest time between two accepted presses of a bind
+static constexpr std::chrono::milliseconds k_bind_debounce(250);
+
+// Auto-repeat of the held Ctrl+-/+ and Ctrl+[/] steps
+static constexpr std::chrono::milliseconds k_step_repeat_delay(300);
+static constexpr std::chrono::milliseconds k_step_repeat_interval(25);
+
+// Press tracking for the user bind keys, guarded by cfg_mutex_
+struct BindState
+{
+    BindingState ctrl_toggle{ k_bind_debounce };
+    BindingState pose_reset{ k_bind_debounce };
+    std::vector< BindingState > user_load;
+};
+
+// Controller driven head orientation, owned by the pose thread
+struct HeadState
+{
+    float pitch = 0.0f; // degrees, clamped to [-90, 90]
+    double yaw = 0.0;   // degrees, wrapped to [-180, 180]
+};
+
+// Press tracking for the fixed Ctrl+F# toggles, owned by the hotkey thread
+struct HotkeyState
+{
+    BindingState save_profile{ k_bind_debounce };
+    BindingState reload_profile{ k_bind_debounce };
+    BindingState toggle_top{ k_bind_debounce };
+    BindingState toggle_height{ k_bind_debounce };
+    BindingState sens_down{ k_bind_debounce, k_step_repeat_delay, k_step_repeat_interval };
+    BindingState sens_up{ k_bind_debounce, k_step_repeat_delay, k_step_repeat_interval };
+    BindingState radius_down{ k_bind_debounce, k_step_repeat_delay, k_step_repeat_interval };
+    BindingState radius_up{ k_bind_debounce, k_step_repeat_delay, k_step_repeat_interval };
+    AdjustRamp depth_ramp;
+    AdjustRamp convergence_ramp;
+    AxisMapper depth_axis;
+    AxisMapper convergence_axis;
+};
+
+// Headset window tracked by the focus thread
+struct FocusState
+{
+    HWND__* vr_window = nullptr;
+};
+
+
+class StereoDisplayComponent : public vr::IVRDisplayComponent
+{
+public:
+    explicit StereoDisplayComponent( const StereoDisplayDriverConfiguration &config );
+
+    // ----- Functions to override vr::IVRDisplayComponent -----
+    bool IsDisplayOnDesktop() override;
+    bool IsDisplayRealDisplay() override;
+    void GetRecommendedRenderTargetSize( uint32_t *pnWidth, uint32_t *pnHeight ) override;
+    void GetEyeOutputViewport( vr::EVREye eEye, uint32_t *pnX, uint32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight ) override;
+    void GetProjectionRaw( vr::EVREye eEye, float *pfLeft, float *pfRight, float *pfTop, float *pfBottom ) override;
+    vr::DistortionCoordinates_t ComputeDistortion( vr::EVREye eEye, float fU, float fV ) override;
+    bool ComputeInverseDistortion(vr::HmdVector2_t* pResult, vr::EVREye eEye, uint32_t unChannel, float fU, float fV) override;
+    void GetWindowBounds( int32_t *pnX, int32_t *pnY, uint32_t *pnWidth, uint32_t *pnHeight ) override;
+    std::shared_ptr< const StereoDisplayDriverConfiguration > GetConfig() const;
+    void AdjustDepth(float new_depth, bool is_delta, uint32_t device_index);
+    void AdjustConvergence(float new_conv, bool is_delta, uint32_t device_index);
+    void CommitChanges(uint32_t device_index);
+    void LogPropertyStats(const char* name) const;
+    float GetDepth();
+    float GetConvergence();
+    void CheckUserSettings(uint32_t device_index, const KeySnapshot& keys);
+    void AdjustSensitivity(float delta);
+    void AdjustRadius(float delta);
+    void SetHeight();
+    void SetReset();
+    void LoadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index);
+    void ReloadSettings(StereoDisplayDriverConfiguration& config, uint32_t device_index);
+
+private:
+    void PublishConfig( std::shared_ptr< const StereoDisplayDriverConfiguration > config );
+    vr::HmdRect2_t ProjectionRect( vr::EVREye eye );
+
+    // Immutable snapshot, readers never lock; writers hold cfg_mutex_
+    SnapshotSlot< StereoDisplayDriverConfiguration > config_;
+    std::atomic< float > depth_;
+    std::atomic< float > convergence_;
+
+    // Guarded by cfg_mutex_
+    BindState bind_state_;
+    std::optional< float > user_height_;
+
+    std::mutex cfg_mutex_;
+
+    // Depth writes, flushed by CommitChanges()
+    PropertyWriter properties_;
+
+    // Set when convergence moved, cleared by CommitChanges()
+    std::atomic< bool > projection_dirty_;
+    // Last frustum sent to vrserver, guarded by projection_mutex_
+    vr::HmdRect2_t committed_left_;
+    vr::HmdRect2_t committed_right_;
+    std::mutex projection_mutex_;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Represents a Mock HMD in the system
+//-----------------------------------------------------------------------------
+class MockControllerDeviceDriver : public vr::ITrackedDeviceServerDriver
+{
+public:
+    MockControllerDeviceDriver();
+    vr::EVRInitError Activate( uint32_t unObjectId ) override;
+    void EnterStandby() override;
+    void *GetComponent( const char *pchComponentNameAndVersion ) override;
+    void DebugRequest( const char *pchRequest, char *pchResponseBuffer, uint32_t unResponseBufferSize ) override;
+    vr::DriverPose_t GetPose() override;
+    void Deactivate() override;
+
+    void PoseUpdateThread();
+    void PollHotkeysThread();
+    void FocusUpdateThread();
+
+    void LoadSettings(const std::string& app_name);
+
+private:
+    InputSample SampleInput();
+    void OnProfileChanged(const std::string& file_name);
+
+    std::unique_ptr< StereoDisplayComponent > stereo_display_component_;
+    std::unique_ptr< GamepadPoller > gamepad_poller_;
+    // Shared by vrserver's thread & the hotkey thread, caches parsed profiles
+    JsonManager json_manager_;
+
+    std::string stereo_model_number_;
+    std::string stereo_serial_number_;
+
+    // Guarded by profile_mutex_, which also serializes profile loads
+    std::string app_name_;
+    std::string profile_file_; // File the current profile came from
+    std::mutex profile_mutex_;
+
+    std::atomic< bool > is_active_;
+    std::atomic< uint32_t > device_index_;
+    std::atomic< bool > is_on_top_;
+
+    SeqLock< vr::DriverPose_t > curr_pose_;
+    InputBus input_bus_;
+    KeyEventSource key_events_;
+    Notifier notifier_;
+    // Ctrl+F7 saves, written off the hotkey thread. Declared after notifier_
+    // so its final flush can still post to it during destruction.
+    ProfileWriter profile_writer_;
+    ProfileWatcher profile_watcher_;
+
+    // Loop state, reset on every Activate()
+    HeadState head_state_;
+    HotkeyState hotkey_state_;
+    FocusState focus_state_;
+
+    std::thread pose_thread_;
+    std::thread hotkey_thread_;
+    std::thread focus_thread_;
+};
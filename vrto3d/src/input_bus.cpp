@@ -0,0 +1,84 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "input_bus.h"
+#include "key_mappings.h"
+
+
+InputBus::InputBus()
+    : head_( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Publish a new sample, must only be called from the sampling stage
+//-----------------------------------------------------------------------------
+InputSample InputBus::Publish( const GamepadState &pad, bool connected, int64_t timestamp_us )
+{
+    InputSample sample = {};
+    sample.sequence = head_.load( std::memory_order_relaxed ) + 1;
+    sample.timestamp_us = timestamp_us;
+    sample.connected = connected;
+    sample.pad = pad;
+
+    if ( connected )
+    {
+        sample.buttons = pad.buttons;
+        if ( pad.left_trigger > XINPUT_GAMEPAD_TRIGGER_THRESHOLD )
+            sample.buttons |= XINPUT_GAMEPAD_LEFT_TRIGGER;
+        if ( pad.right_trigger > XINPUT_GAMEPAD_TRIGGER_THRESHOLD )
+            sample.buttons |= XINPUT_GAMEPAD_RIGHT_TRIGGER;
+    }
+
+    ring_[ sample.sequence % k_capacity ].Store( sample );
+    head_.store( sample.sequence, std::memory_order_release );
+    return sample;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Most recent sample, zeroed and disconnected before the first publish
+//-----------------------------------------------------------------------------
+InputSample InputBus::Latest() const
+{
+    uint64_t head = head_.load( std::memory_order_acquire );
+    return ring_[ head % k_capacity ].Load();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Latest sample with the buttons of every sample since cursor OR'd in,
+// so a consumer slower than the sampler never misses a short press
+//-----------------------------------------------------------------------------
+InputSample InputBus::Collect( uint64_t &cursor ) const
+{
+    InputSample latest = {};
+    uint32_t buttons = 0;
+    bool connected = false;
+    ReadSince( cursor, [&]( const InputSample &sample ) {
+        buttons |= sample.buttons;
+        connected |= sample.connected;
+        latest = sample;
+    } );
+
+    if ( latest.sequence == 0 )
+        return Latest();
+
+    latest.buttons = buttons;
+    latest.connected = connected;
+    return latest;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "seqlock.h"
+
+
+// Raw gamepad state, mirrors XINPUT_GAMEPAD without pulling in windows headers
+struct GamepadState
+{
+    uint16_t buttons;
+    uint8_t left_trigger;
+    uint8_t right_trigger;
+    int16_t thumb_lx;
+    int16_t thumb_ly;
+    int16_t thumb_rx;
+    int16_t thumb_ry;
+};
+
+// One timestamped controller sample as seen by every consumer
+struct InputSample
+{
+    uint64_t sequence;
+    int64_t timestamp_us;
+    bool connected;
+    uint32_t buttons; // wButtons plus the trigger pseudo-buttons from key_mappings.h
+    GamepadState pad;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Lock-free ring of controller samples. A single sampling stage
+// publishes one sample per tick and any number of consumers read the latest
+// sample or walk everything published since their last read.
+//-----------------------------------------------------------------------------
+class InputBus
+{
+public:
+    InputBus();
+
+    InputSample Publish( const GamepadState &pad, bool connected, int64_t timestamp_us );
+    InputSample Latest() const;
+    InputSample Collect( uint64_t &cursor ) const;
+
+    template < typename Fn >
+    void ReadSince( uint64_t &cursor, Fn &&fn ) const
+    {
+        uint64_t head = head_.load( std::memory_order_acquire );
+        uint64_t first = cursor + 1;
+        if ( head >= k_capacity && first < head - k_capacity + 1 )
+            first = head - k_capacity + 1;
+
+        for ( uint64_t seq = first; seq <= head; seq++ )
+        {
+            InputSample sample = ring_[ seq % k_capacity ].Load();
+            // Skip slots the producer already lapped
+            if ( sample.sequence == seq )
+                fn( sample );
+        }
+        cursor = head;
+    }
+
+private:
+    static constexpr size_t k_capacity = 16;
+
+    std::array< SeqLock< InputSample >, k_capacity > ring_;
+    std::atomic< uint64_t > head_;
+};
@@ -1,398 +1,422 @@
-/*
- * This file is part of VRto3D.
- *
- * VRto3D is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * VRto3D is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
- * GNU Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public License
- * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
- */
-
-#include "json_manager.h"
-#include "driverlog.h"
-#include "key_mappings.h"
-
-#include <windows.h>
-#include <shlobj.h>
-#include <fstream>
-#include <filesystem>
-#include <unordered_map>
-#include <iomanip>
-#include <sstream>
-
-// Include the nlohmann/json library
-#include <nlohmann/json.hpp>
-
-JsonManager::JsonManager() {
-    vrto3dFolder = getDocumentsFolderPath();
-    if (vrto3dFolder != "")
-    {
-        createFolderIfNotExist(vrto3dFolder);
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Get path to user's Documents folder
-//-----------------------------------------------------------------------------
-std::string JsonManager::getDocumentsFolderPath() {
-    PWSTR path = NULL;
-    HRESULT hr = SHGetKnownFolderPath(FOLDERID_Documents, 0, NULL, &path);
-    if (SUCCEEDED(hr)) {
-        char charPath[MAX_PATH];
-        size_t convertedChars = 0;
-        wcstombs_s(&convertedChars, charPath, MAX_PATH, path, _TRUNCATE);
-        CoTaskMemFree(path);
-        return std::string(charPath) + "\\My Games\\vrto3d";
-    }
-    else {
-        DriverLog("Failed to get Documents folder path\n");
-        return "";
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Create vrto3d folder if it doesn't exist
-//-----------------------------------------------------------------------------
-void JsonManager::createFolderIfNotExist(const std::string& path) {
-    if (!std::filesystem::exists(path)) {
-        std::filesystem::create_directories(path);
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Write a JSON to Documents/My Games/vrto3d
-//-----------------------------------------------------------------------------
-void JsonManager::writeJsonToFile(const std::string& fileName, const nlohmann::ordered_json& jsonData) {
-    std::string filePath = vrto3dFolder + "\\" + fileName;
-    std::ofstream file(filePath);
-    if (file.is_open()) {
-        file << jsonData.dump(4); // Pretty-print the JSON with an indent of 4 spaces
-        file.close();
-        DriverLog("Saved profile: %s\n", fileName.c_str());
-    }
-    else {
-        DriverLog("Failed to save profile: %s\n", fileName.c_str());
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Read a JSON from Documents/My Games/vrto3d
-//-----------------------------------------------------------------------------
-nlohmann::json JsonManager::readJsonFromFile(const std::string& fileName) {
-    std::string filePath = vrto3dFolder + "\\" + fileName;
-    std::ifstream file(filePath);
-    if (file.is_open()) {
-        nlohmann::json jsonData;
-        file >> jsonData;
-        file.close();
-        return jsonData;
-    }
-    else {
-        return {};
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Split a string by a delimiter
-//-----------------------------------------------------------------------------
-std::vector<std::string> JsonManager::split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
-    }
-
-    return tokens;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Create default_config.json if it doesn't exist
-//-----------------------------------------------------------------------------
-void JsonManager::EnsureDefaultConfigExists()
-{
-    // Check if the file exists
-    std::string filePath = vrto3dFolder + "\\" + DEF_CFG;
-    if (!std::filesystem::exists(filePath)) {
-        DriverLog("%s does not exist. Writing default config to file...\n", DEF_CFG.c_str());
-
-        // Create the example default JSON
-        nlohmann::ordered_json defaultConfig = {
-            {"window_width", 1920},
-            {"window_height", 1080},
-            {"render_width", 1920},
-            {"render_height", 1080},
-            {"hmd_height", 1.0},
-            {"aspect_ratio", 1.77778},
-            {"fov", 90.0},
-            {"depth", 0.5},
-            {"convergence", 0.02},
-            {"disable_hotkeys", false},
-            {"tab_enable", false},
-            {"reverse_enable", false},
-            {"depth_gauge", false},
-            {"debug_enable", true},
-            {"display_latency", 0.011},
-            {"display_frequency", 60.0},
-            {"pitch_enable", false},
-            {"yaw_enable", false},
-            {"pose_reset_key", "VK_NUMPAD7"},
-            {"ctrl_toggle_key", "XINPUT_GAMEPAD_RIGHT_THUMB"},
-            {"ctrl_toggle_type", "toggle"},
-            {"pitch_radius", 0.0},
-            {"ctrl_deadzone", 0.05},
-            {"ctrl_sensitivity", 1.0},
-            {"user_settings", {
-                {
-                    {"user_load_key", "VK_NUMPAD1"},
-                    {"user_store_key", "VK_NUMPAD4"},
-                    {"user_key_type", "switch"},
-                    {"user_depth", 0.5},
-                    {"user_convergence", 0.02}
-                },
-                {
-                    {"user_load_key", "XINPUT_GAMEPAD_GUIDE"},
-                    {"user_store_key", "VK_NUMPAD5"},
-                    {"user_key_type", "toggle"},
-                    {"user_depth", 0.1},
-                    {"user_convergence", 0.02}
-                },
-                {
-                    {"user_load_key", "XINPUT_GAMEPAD_LEFT_TRIGGER"},
-                    {"user_store_key", "VK_NUMPAD6"},
-                    {"user_key_type", "hold"},
-                    {"user_depth", 0.25},
-                    {"user_convergence", 0.02}
-                }
-            }}
-        };
-
-        // Write the default JSON to file
-        std::ofstream file(filePath);
-        if (file.is_open()) {
-            file << defaultConfig.dump(4); // Pretty-print with 4 spaces of indentation
-            file.close();
-            DriverLog("Default config written to %s\n", DEF_CFG.c_str());
-        }
-        else {
-            DriverLog("Failed to open %s for writing\n", DEF_CFG.c_str());
-        }
-    }
-    else {
-        DriverLog("Default config already exists\n");
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Load the VRto3D display from a JSON file
-//-----------------------------------------------------------------------------
-void JsonManager::LoadParamsFromJson(StereoDisplayDriverConfiguration& config)
-{
-    // Read the JSON configuration from the file
-    nlohmann::json jsonConfig = readJsonFromFile(DEF_CFG);
-    
-    try {
-        // Load values directly from the base level of the JSON
-        config.window_width = jsonConfig.at("window_width").get<int>();
-        config.window_height = jsonConfig.at("window_height").get<int>();
-        config.render_width = jsonConfig.at("render_width").get<int>();
-        config.render_height = jsonConfig.at("render_height").get<int>();
-
-        config.aspect_ratio = jsonConfig.at("aspect_ratio").get<float>();
-        config.fov = jsonConfig.at("fov").get<float>();
-
-        config.disable_hotkeys = jsonConfig.at("disable_hotkeys").get<bool>();
-        config.debug_enable = jsonConfig.at("debug_enable").get<bool>();
-        config.tab_enable = jsonConfig.at("tab_enable").get<bool>();
-        config.reverse_enable = jsonConfig.at("reverse_enable").get<bool>();
-        config.depth_gauge = jsonConfig.at("depth_gauge").get<bool>();
-
-        config.display_latency = jsonConfig.at("display_latency").get<float>();
-        config.display_frequency = jsonConfig.at("display_frequency").get<float>();
-        config.sleep_count_max = (int)(floor(1600.0 / (1000.0 / config.display_frequency)));
-    }
-    catch (const nlohmann::json::exception& e) {
-        DriverLog("Error reading default_config.json: %s\n", e.what());
-    }
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Load a VRto3D profile from a JSON file
-//-----------------------------------------------------------------------------
-bool JsonManager::LoadProfileFromJson(const std::string& filename, StereoDisplayDriverConfiguration& config)
-{
-    // Read the JSON configuration from the file
-    nlohmann::json jsonConfig = readJsonFromFile(filename);
-
-    if (jsonConfig.is_null() && filename != DEF_CFG) {
-        DriverLog("No profile found for %s\n", filename.c_str());
-        return false;
-    }
-
-    try {
-        // Profile settings
-        config.hmd_height = jsonConfig.at("hmd_height").get<float>();
-        config.depth = jsonConfig.at("depth").get<float>();
-        config.convergence = jsonConfig.at("convergence").get<float>();
-
-        // Controller settings
-        config.pitch_enable = jsonConfig.at("pitch_enable").get<bool>();
-        config.pitch_set = config.pitch_enable;
-        config.yaw_enable = jsonConfig.at("yaw_enable").get<bool>();
-        config.yaw_set = config.yaw_enable;
-
-        config.pose_reset_str = jsonConfig.at("pose_reset_key").get<std::string>();
-        
-        if (VirtualKeyMappings.find(config.pose_reset_str) != VirtualKeyMappings.end()) {
-            config.pose_reset_key = VirtualKeyMappings[config.pose_reset_str];
-            config.reset_xinput = false;
-        }
-        else if (XInputMappings.find(config.pose_reset_str) != XInputMappings.end() || config.pose_reset_str.find('+') != std::string::npos) {
-            config.pose_reset_key = 0x0;
-            auto hotkeys = split(config.pose_reset_str, '+');
-            for (const auto& hotkey : hotkeys) {
-                if (XInputMappings.find(hotkey) != XInputMappings.end()) {
-                    config.pose_reset_key |= XInputMappings[hotkey];
-                }
-            }
-            config.reset_xinput = true;
-        }
-        config.pose_reset = true;
-
-        config.ctrl_toggle_str = jsonConfig.at("ctrl_toggle_key").get<std::string>();
-        if (VirtualKeyMappings.find(config.ctrl_toggle_str) != VirtualKeyMappings.end()) {
-            config.ctrl_toggle_key = VirtualKeyMappings[config.ctrl_toggle_str];
-            config.ctrl_xinput = false;
-        }
-        else if (XInputMappings.find(config.ctrl_toggle_str) != XInputMappings.end() || config.ctrl_toggle_str.find('+') != std::string::npos) {
-            config.ctrl_toggle_key = 0x0;
-            auto hotkeys = split(config.ctrl_toggle_str, '+');
-            for (const auto& hotkey : hotkeys) {
-                if (XInputMappings.find(hotkey) != XInputMappings.end()) {
-                    config.ctrl_toggle_key |= XInputMappings[hotkey];
-                }
-            }
-            config.ctrl_xinput = true;
-        }
-
-        config.ctrl_type_str = jsonConfig.at("ctrl_toggle_type").get<std::string>();
-        config.ctrl_type = KeyBindTypes[config.ctrl_type_str];
-
-        config.pitch_radius = jsonConfig.at("pitch_radius").get<float>();
-        config.ctrl_deadzone = jsonConfig.at("ctrl_deadzone").get<float>();
-        config.ctrl_sensitivity = jsonConfig.at("ctrl_sensitivity").get<float>();
-
-        // Read user binds from user_settings array
-        const auto& user_settings_array = jsonConfig.at("user_settings");
-
-        // Resize vectors based on the size of the user_settings array
-        config.num_user_settings = user_settings_array.size();
-        config.user_load_key.resize(config.num_user_settings);
-        config.user_store_key.resize(config.num_user_settings);
-        config.user_key_type.resize(config.num_user_settings);
-        config.user_depth.resize(config.num_user_settings);
-        config.user_convergence.resize(config.num_user_settings);
-        config.prev_depth.resize(config.num_user_settings);
-        config.prev_convergence.resize(config.num_user_settings);
-        config.was_held.resize(config.num_user_settings);
-        config.load_xinput.resize(config.num_user_settings);
-        config.sleep_count.resize(config.num_user_settings);
-        config.user_load_str.resize(config.num_user_settings);
-        config.user_store_str.resize(config.num_user_settings);
-        config.user_type_str.resize(config.num_user_settings);
-
-        for (size_t i = 0; i < config.num_user_settings; ++i) {
-            const auto& user_setting = user_settings_array.at(i);
-
-            config.user_load_str[i] = user_setting.at("user_load_key").get<std::string>();
-            if (VirtualKeyMappings.find(config.user_load_str[i]) != VirtualKeyMappings.end()) {
-                config.user_load_key[i] = VirtualKeyMappings[config.user_load_str[i]];
-                config.load_xinput[i] = false;
-            }
-            else if (XInputMappings.find(config.user_load_str[i]) != XInputMappings.end() || config.user_load_str[i].find('+') != std::string::npos) {
-                config.user_load_key[i] = 0x0;
-                auto hotkeys = split(config.user_load_str[i], '+');
-                for (const auto& hotkey : hotkeys) {
-                    if (XInputMappings.find(hotkey) != XInputMappings.end()) {
-                        config.user_load_key[i] |= XInputMappings[hotkey];
-                    }
-                }
-                config.load_xinput[i] = true;
-            }
-
-            config.user_store_str[i] = user_setting.at("user_store_key").get<std::string>();
-            if (VirtualKeyMappings.find(config.user_store_str[i]) != VirtualKeyMappings.end()) {
-                config.user_store_key[i] = VirtualKeyMappings[config.user_store_str[i]];
-            }
-
-            config.user_type_str[i] = user_setting.at("user_key_type").get<std::string>();
-            if (KeyBindTypes.find(config.user_type_str[i]) != KeyBindTypes.end()) {
-                config.user_key_type[i] = KeyBindTypes[config.user_type_str[i]];
-            }
-
-            config.user_depth[i] = user_setting.at("user_depth").get<float>();
-            config.user_convergence[i] = user_setting.at("user_convergence").get<float>();
-        }
-
-    }
-    catch (const nlohmann::json::exception& e) {
-        DriverLog("Error reading config from %s: %s\n", filename.c_str(), e.what());
-        return false;
-    }
-
-    return true;
-}
-
-
-//-----------------------------------------------------------------------------
-// Purpose: Save Game Specific Settings to Documents\My games\vrto3d\app_name_config.json
-//-----------------------------------------------------------------------------
-void JsonManager::SaveProfileToJson(const std::string& filename, StereoDisplayDriverConfiguration& config)
-{
-    // Create a JSON object to hold all the configuration data
-    nlohmann::ordered_json jsonConfig;
-
-    // Populate the JSON object with settings
-    jsonConfig["hmd_height"] = config.hmd_height;
-    jsonConfig["depth"] = config.depth;
-    jsonConfig["convergence"] = config.convergence;
-    jsonConfig["pitch_enable"] = config.pitch_enable;
-    jsonConfig["yaw_enable"] = config.yaw_enable;
-    jsonConfig["pose_reset_key"] = config.pose_reset_str;
-    jsonConfig["ctrl_toggle_key"] = config.ctrl_toggle_str;
-    jsonConfig["ctrl_toggle_type"] = config.ctrl_type_str;
-    jsonConfig["pitch_radius"] = config.pitch_radius;
-    jsonConfig["ctrl_deadzone"] = config.ctrl_deadzone;
-    jsonConfig["ctrl_sensitivity"] = config.ctrl_sensitivity;
-
-    // Store user settings as an array
-    for (int i = 0; i < config.num_user_settings; i++) {
-        nlohmann::ordered_json userSettings;
-        userSettings["user_load_key"] = config.user_load_str[i];
-        userSettings["user_store_key"] = config.user_store_str[i];
-        userSettings["user_key_type"] = config.user_type_str[i];
-        userSettings["user_depth"] = config.user_depth[i];
-        userSettings["user_convergence"] = config.user_convergence[i];
-
-        // Append to JSON array in the main config
-        jsonConfig["user_settings"].push_back(userSettings);
-    }
-
-    writeJsonToFile(filename, jsonConfig);
-}
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "json_manager.h"
+#include "driverlog.h"
+
+#include <windows.h>
+#include <shlobj.h>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <iomanip>
+#include <sstream>
+
+// Include the nlohmann/json library
+#include <nlohmann/json.hpp>
+
+
+JsonManager::JsonManager() {
+    vrto3dFolder = getDocumentsFolderPath();
+    if (vrto3dFolder != "")
+    {
+        createFolderIfNotExist(vrto3dFolder);
+        cacheFolder = vrto3dFolder + "\\cache";
+        createFolderIfNotExist(cacheFolder);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Get path to user's Documents folder
+//-----------------------------------------------------------------------------
+std::string JsonManager::getDocumentsFolderPath() {
+    PWSTR path = NULL;
+    HRESULT hr = SHGetKnownFolderPath(FOLDERID_Documents, 0, NULL, &path);
+    if (SUCCEEDED(hr)) {
+        char charPath[MAX_PATH];
+        size_t convertedChars = 0;
+        wcstombs_s(&convertedChars, charPath, MAX_PATH, path, _TRUNCATE);
+        CoTaskMemFree(path);
+        return std::string(charPath) + "\\My Games\\vrto3d";
+    }
+    else {
+        DriverLog("Failed to get Documents folder path\n");
+        return "";
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Create vrto3d folder if it doesn't exist
+//-----------------------------------------------------------------------------
+void JsonManager::createFolderIfNotExist(const std::string& path) {
+    if (!std::filesystem::exists(path)) {
+        std::filesystem::create_directories(path);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Write a JSON to Documents/My Games/vrto3d. The data goes to a temp
+// file that is flushed to disk and then renamed over the profile, so a crash
+// mid-save leaves either the old or the new profile, never half of one.
+//-----------------------------------------------------------------------------
+bool JsonManager::writeJsonToFile(const std::string& fileName, const nlohmann::ordered_json& jsonData) {
+    std::string filePath = vrto3dFolder + "\\" + fileName;
+    std::string tempPath = filePath + ".tmp";
+    std::string text = jsonData.dump(4); // Pretty-print the JSON with an indent of 4 spaces
+
+    HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        DriverLog("Failed to save profile: %s: %d\n", fileName.c_str(), GetLastError());
+        return false;
+    }
+    DWORD written = 0;
+    bool ok = WriteFile(file, text.data(), (DWORD)text.size(), &written, NULL) && written == text.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (ok) {
+        ok = MoveFileExA(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    }
+    if (!ok) {
+        DriverLog("Failed to save profile: %s: %d\n", fileName.c_str(), GetLastError());
+        DeleteFileA(tempPath.c_str());
+        return false;
+    }
+
+    DriverLog("Saved profile: %s\n", fileName.c_str());
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Read a JSON from Documents/My Games/vrto3d compiled for binding.
+// Compiled files are kept in a small LRU cache, so loading an unchanged
+// profile again only costs a stat of the file. A missing file reads as an
+// empty profile, one that doesn't parse returns nullptr.
+//-----------------------------------------------------------------------------
+std::shared_ptr<const CompiledProfile> JsonManager::readProfile(const std::string& fileName) {
+    std::string filePath = vrto3dFolder + "\\" + fileName;
+
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &attributes)) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto cached = profileCache.find(fileName);
+        if (cached != profileCache.end()) {
+            profileLru.erase(cached->second.lru);
+            profileCache.erase(cached);
+        }
+        return std::make_shared<const CompiledProfile>();
+    }
+    uint64_t size = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+    uint64_t writeTime = ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto cached = profileCache.find(fileName);
+        if (cached != profileCache.end() && cached->second.size == size && cached->second.write_time == writeTime) {
+            profileLru.splice(profileLru.begin(), profileLru, cached->second.lru);
+            return cached->second.profile;
+        }
+    }
+
+    // Load outside the lock, the other thread may load a different profile.
+    // Prefer the compiled sidecar, the text is only parsed when it changed
+    auto profile = std::make_shared<CompiledProfile>();
+    if (!readSidecar(fileName, size, writeTime, *profile)) {
+        std::ifstream file(filePath);
+        if (!file.is_open()) {
+            return std::make_shared<const CompiledProfile>();
+        }
+        nlohmann::json jsonData;
+        try {
+            file >> jsonData;
+        }
+        catch (const nlohmann::json::exception& e) {
+            // Often a half-saved file, keep whatever is cached until it parses
+            DriverLog("Error parsing %s: %s\n", fileName.c_str(), e.what());
+            return nullptr;
+        }
+        file.close();
+        *profile = CompileProfile(jsonData, size, writeTime, fileName);
+        writeSidecar(fileName, *profile);
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto cached = profileCache.find(fileName);
+    if (cached == profileCache.end()) {
+        if (profileCache.size() >= k_profile_cache_size) {
+            profileCache.erase(profileLru.back());
+            profileLru.pop_back();
+        }
+        profileLru.push_front(fileName);
+        cached = profileCache.emplace(fileName, CachedProfile{ 0, 0, nullptr, profileLru.begin() }).first;
+    }
+    else {
+        profileLru.splice(profileLru.begin(), profileLru, cached->second.lru);
+    }
+    cached->second.size = size;
+    cached->second.write_time = writeTime;
+    cached->second.profile = profile;
+    return profile;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load a JSON file's compiled sidecar from the cache folder. It is
+// read straight into the profile in one call and checked there; the layout
+// is fixed, so nothing else needs decoding. Returns false if there is none or
+// it is out of date.
+//-----------------------------------------------------------------------------
+bool JsonManager::readSidecar(const std::string& fileName, uint64_t size, uint64_t writeTime, CompiledProfile& profile) {
+    if (cacheFolder.empty()) {
+        return false;
+    }
+    std::string sidecarPath = cacheFolder + "\\" + fileName + ".bin";
+    HANDLE file = CreateFileA(sidecarPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    bool loaded = false;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && fileSize.QuadPart <= MAXDWORD) {
+        profile.resize((size_t)fileSize.QuadPart);
+        DWORD read = 0;
+        loaded = ReadFile(file, profile.data(), (DWORD)profile.size(), &read, NULL) && read == profile.size() &&
+            ValidateProfile(profile.data(), profile.size(), size, writeTime);
+    }
+    CloseHandle(file);
+
+    if (!loaded) {
+        profile.clear();
+    }
+    return loaded;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Write a compiled JSON file out as its sidecar. The sidecar is only
+// a cache, so a failed write just means the text gets parsed again next time.
+//-----------------------------------------------------------------------------
+void JsonManager::writeSidecar(const std::string& fileName, const CompiledProfile& profile) {
+    if (cacheFolder.empty()) {
+        return;
+    }
+
+    std::string sidecarPath = cacheFolder + "\\" + fileName + ".bin";
+    std::string tempPath = sidecarPath + ".tmp";
+    HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    DWORD written = 0;
+    bool ok = WriteFile(file, profile.data(), (DWORD)profile.size(), &written, NULL) && written == profile.size();
+    CloseHandle(file);
+
+    // Readers only ever see a complete sidecar
+    if (!ok || !MoveFileExA(tempPath.c_str(), sidecarPath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileA(tempPath.c_str());
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Create default_config.json if it doesn't exist
+//-----------------------------------------------------------------------------
+void JsonManager::EnsureDefaultConfigExists()
+{
+    // Check if the file exists
+    std::string filePath = vrto3dFolder + "\\" + DEF_CFG;
+    if (!std::filesystem::exists(filePath)) {
+        DriverLog("%s does not exist. Writing default config to file...\n", DEF_CFG.c_str());
+
+        // Create the example default JSON from the field defaults
+        nlohmann::ordered_json defaultConfig = DefaultsToJson();
+
+        // Example user presets
+        defaultConfig[k_user_settings_key] = {
+            {
+                {"user_load_key", "VK_NUMPAD1"},
+                {"user_store_key", "VK_NUMPAD4"},
+                {"user_key_type", "switch"},
+                {"user_depth", 0.5},
+                {"user_convergence", 0.02}
+            },
+            {
+                {"user_load_key", "XINPUT_GAMEPAD_GUIDE"},
+                {"user_store_key", "VK_NUMPAD5"},
+                {"user_key_type", "toggle"},
+                {"user_depth", 0.1},
+                {"user_convergence", 0.02}
+            },
+            {
+                {"user_load_key", "XINPUT_GAMEPAD_LEFT_TRIGGER"},
+                {"user_store_key", "VK_NUMPAD6"},
+                {"user_key_type", "hold"},
+                {"user_depth", 0.25},
+                {"user_convergence", 0.02}
+            }
+        };
+
+        // Write the default JSON to file
+        std::ofstream file(filePath);
+        if (file.is_open()) {
+            file << defaultConfig.dump(4); // Pretty-print with 4 spaces of indentation
+            file.close();
+            DriverLog("Default config written to %s\n", DEF_CFG.c_str());
+        }
+        else {
+            DriverLog("Failed to open %s for writing\n", DEF_CFG.c_str());
+        }
+    }
+    else {
+        DriverLog("Default config already exists\n");
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load the VRto3D display from a JSON file
+//-----------------------------------------------------------------------------
+void JsonManager::LoadParamsFromJson(StereoDisplayDriverConfiguration& config)
+{
+    // Read the JSON configuration from the file
+    // Built-in defaults if it doesn't parse
+    auto profile = readProfile(DEF_CFG);
+    BindParams(profile ? *profile : CompiledProfile(), config, DEF_CFG);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load a VRto3D profile from a JSON file
+//-----------------------------------------------------------------------------
+bool JsonManager::LoadProfileFromJson(const std::string& filename, StereoDisplayDriverConfiguration& config)
+{
+    // Read the JSON configuration from the file
+    auto profile = readProfile(filename);
+    if (!profile) {
+        return false;
+    }
+
+    if (profile->empty() && filename != DEF_CFG) {
+        DriverLog("No profile found for %s\n", filename.c_str());
+        return false;
+    }
+
+    if (filename == DEF_CFG) {
+        bindProfile(*profile, config, filename, nullptr);
+        std::lock_guard<std::mutex> lock(defaultsMutex);
+        profileDefaults = std::make_shared<const StereoDisplayDriverConfiguration>(config);
+        defaultsProfile = profile;
+    }
+    else {
+        // Settings the profile leaves out come from default_config.json
+        bindProfile(*profile, config, filename, getProfileDefaults().get());
+    }
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Reset the profile settings to the built-in defaults
+//-----------------------------------------------------------------------------
+void JsonManager::ResetProfile(StereoDisplayDriverConfiguration& config)
+{
+    bindProfile(CompiledProfile(), config, DEF_CFG, nullptr);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: The profile settings of default_config.json, rebound when it changes
+//-----------------------------------------------------------------------------
+std::shared_ptr<const StereoDisplayDriverConfiguration> JsonManager::getProfileDefaults()
+{
+    auto profile = readProfile(DEF_CFG);
+
+    std::lock_guard<std::mutex> lock(defaultsMutex);
+    // Keep the last good defaults while default_config.json doesn't parse
+    if (profileDefaults && (!profile || profile == defaultsProfile)) {
+        return profileDefaults;
+    }
+
+    auto defaults = std::make_shared<StereoDisplayDriverConfiguration>();
+    bindProfile(profile ? *profile : CompiledProfile(), *defaults, DEF_CFG, nullptr);
+    profileDefaults = defaults;
+    defaultsProfile = profile;
+    return profileDefaults;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Bind the profile fields & user settings of a compiled profile
+//-----------------------------------------------------------------------------
+void JsonManager::bindProfile(const CompiledProfile& profile, StereoDisplayDriverConfiguration& config, const std::string& filename, const StereoDisplayDriverConfiguration* defaults)
+{
+    // Profile & controller settings, user binds from the user_settings array
+    BindProfile(profile, config, filename, defaults);
+    config.pitch_set = config.pitch_enable;
+    config.yaw_set = config.yaw_enable;
+    config.pose_reset = true;
+
+    compileBindings(config, filename);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Save Game Specific Settings to Documents\My games\vrto3d\app_name_config.json
+//-----------------------------------------------------------------------------
+bool JsonManager::SaveProfileToJson(const std::string& filename, const StereoDisplayDriverConfiguration& config)
+{
+    return writeJsonToFile(filename, ProfileToJson(config));
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Compile the key chords into binds, collect every key they use and
+// report names that weren't recognised and binds that overlap
+//-----------------------------------------------------------------------------
+void JsonManager::compileBindings(StereoDisplayDriverConfiguration& config, const std::string& filename)
+{
+    std::vector<std::pair<std::string, KeyBinding>> named;
+    auto compile = [&](const std::string& field, const std::string& chord) {
+        std::vector<std::string> unknown;
+        KeyBinding binding = CompileChord(chord, &unknown);
+        for (const auto& name : unknown) {
+            DriverLog("%s: unknown key %s in %s\n", filename.c_str(), name.c_str(), field.c_str());
+        }
+        config.bound_keys |= binding.keys;
+        named.emplace_back(field, binding);
+        return binding;
+    };
+
+    config.bound_keys.reset();
+    config.pose_reset_bind = compile("pose_reset_key", config.pose_reset_str);
+    config.ctrl_toggle_bind = compile("ctrl_toggle_key", config.ctrl_toggle_str);
+
+    config.user_load_bind.resize(config.num_user_settings);
+    config.user_store_bind.resize(config.num_user_settings);
+    for (size_t i = 0; i < config.num_user_settings; ++i) {
+        config.user_load_bind[i] = compile("user_load_key" + std::to_string(i + 1), config.user_load_str[i]);
+        config.user_store_bind[i] = compile("user_store_key" + std::to_string(i + 1), config.user_store_str[i]);
+    }
+
+    for (const auto& conflict : FindChordConflicts(named)) {
+        DriverLog("%s: %s\n", filename.c_str(), conflict.c_str());
+    }
+}
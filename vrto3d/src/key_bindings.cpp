@@ -0,0 +1,122 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "key_bindings.h"
+#include "key_mappings.h"
+
+#include <windows.h>
+
+
+KeyBinding CompileChord( const std::string &chord, std::vector< std::string > *unknown )
+{
+    KeyBinding binding;
+    size_t start = 0;
+    while ( start <= chord.size() )
+    {
+        size_t end = chord.find( '+', start );
+        if ( end == std::string::npos )
+            end = chord.size();
+        std::string name = chord.substr( start, end - start );
+        start = end + 1;
+
+        if ( name.empty() )
+            continue;
+
+        auto vk = VirtualKeyMappings.find( name );
+        auto xinput = XInputMappings.find( name );
+        if ( vk != VirtualKeyMappings.end() && vk->second > 0 && vk->second < 256 )
+            binding.keys.set( vk->second );
+        else if ( xinput != XInputMappings.end() )
+            binding.buttons |= static_cast< uint32_t >( xinput->second );
+        else if ( unknown )
+            unknown->push_back( name );
+    }
+    return binding;
+}
+
+
+std::vector< std::string > FindChordConflicts( const std::vector< std::pair< std::string, KeyBinding > > &binds )
+{
+    auto contains = []( const KeyBinding &outer, const KeyBinding &inner ) {
+        return ( outer.keys & inner.keys ) == inner.keys && ( outer.buttons & inner.buttons ) == inner.buttons;
+    };
+
+    std::vector< std::string > conflicts;
+    for ( size_t i = 0; i < binds.size(); i++ )
+    {
+        const auto &a = binds[ i ];
+        if ( a.second.IsEmpty() )
+            continue;
+        for ( size_t j = i + 1; j < binds.size(); j++ )
+        {
+            const auto &b = binds[ j ];
+            if ( b.second.IsEmpty() )
+                continue;
+            if ( contains( a.second, b.second ) && contains( b.second, a.second ) )
+                conflicts.push_back( a.first + " and " + b.first + " use the same keys" );
+            else if ( contains( a.second, b.second ) )
+                conflicts.push_back( a.first + " also triggers " + b.first );
+            else if ( contains( b.second, a.second ) )
+                conflicts.push_back( b.first + " also triggers " + a.first );
+        }
+    }
+    return conflicts;
+}
+
+
+KeyBinding MakeKeyChord( std::initializer_list< int > keys )
+{
+    KeyBinding binding;
+    for ( int key : keys )
+        binding.keys.set( key );
+    return binding;
+}
+
+
+KeySnapshot::KeySnapshot()
+    : input_{}
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Read every key in keys once and keep the controller sample and
+// the time the snapshot stands for
+//-----------------------------------------------------------------------------
+void KeySnapshot::Capture( const KeySet &keys, const InputSample &input, Clock::time_point now )
+{
+    down_.reset();
+    for ( int key = 1; key < 256; key++ )
+    {
+        if ( keys.test( key ) && ( GetAsyncKeyState( key ) & 0x8000 ) )
+            down_.set( key );
+    }
+    input_ = input;
+    time_ = now;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: True if every key and button of the bind is down
+//-----------------------------------------------------------------------------
+bool KeySnapshot::IsHeld( const KeyBinding &binding ) const
+{
+    if ( binding.IsEmpty() )
+        return false;
+    if ( binding.buttons != 0 && ( !input_.connected || ( input_.buttons & binding.buttons ) != binding.buttons ) )
+        return false;
+    return ( down_ & binding.keys ) == binding.keys;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "input_bus.h"
+
+
+// One bit per virtual key code
+using KeySet = std::bitset< 256 >;
+
+
+//-----------------------------------------------------------------------------
+// Purpose: A compiled bind, held when every key in keys and every controller
+// button in buttons is down. An empty bind is never held.
+//-----------------------------------------------------------------------------
+struct KeyBinding
+{
+    KeySet keys;
+    uint32_t buttons = 0;
+
+    bool IsEmpty() const { return keys.none() && buttons == 0; }
+};
+
+// Compile a '+' joined chord of VK_* keys, mouse buttons and XINPUT_* buttons,
+// names that aren't recognised are appended to unknown and left out
+KeyBinding CompileChord( const std::string &chord, std::vector< std::string > *unknown = nullptr );
+
+// Describe every pair of named binds where holding one also holds the other
+std::vector< std::string > FindChordConflicts( const std::vector< std::pair< std::string, KeyBinding > > &binds );
+
+// Build a keyboard chord, e.g. { VK_CONTROL, VK_F3 }
+KeyBinding MakeKeyChord( std::initializer_list< int > keys );
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Keyboard and controller state captured once per tick. Only the
+// keys some bind uses are read, each exactly once, so the cost depends on
+// the number of distinct keys rather than the number of binds.
+//-----------------------------------------------------------------------------
+class KeySnapshot
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    KeySnapshot();
+
+    void Capture( const KeySet &keys, const InputSample &input, Clock::time_point now );
+
+    bool IsHeld( const KeyBinding &binding ) const;
+    bool IsDown( int key ) const { return key > 0 && key < 256 && down_.test( key ); }
+    bool AnyDown() const { return down_.any(); }
+    const KeySet &Down() const { return down_; }
+    const InputSample &Input() const { return input_; }
+    Clock::time_point Time() const { return time_; }
+
+private:
+    KeySet down_;
+    InputSample input_;
+    Clock::time_point time_;
+};
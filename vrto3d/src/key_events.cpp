@@ -0,0 +1,239 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "key_events.h"
+#include "driverlog.h"
+
+#include <future>
+
+#include <windows.h>
+
+
+// Only one hook can deliver to an instance, the hook callback has no user data
+static std::atomic< KeyEventSource * > hook_target( nullptr );
+
+// How long a poll may disagree with the hook before it's considered removed,
+// well above the delay between the hook firing and the key state updating
+static constexpr std::chrono::milliseconds k_hook_grace( 100 );
+
+// The hook reports left & right modifiers, GetAsyncKeyState() also the generic ones
+static const struct
+{
+    uint32_t generic, left, right;
+} k_modifiers[] = {
+    { VK_SHIFT, VK_LSHIFT, VK_RSHIFT },
+    { VK_CONTROL, VK_LCONTROL, VK_RCONTROL },
+    { VK_MENU, VK_LMENU, VK_RMENU },
+};
+
+
+static LRESULT CALLBACK LowLevelKeyboardProc( int code, WPARAM wparam, LPARAM lparam )
+{
+    if ( code == HC_ACTION )
+    {
+        const KBDLLHOOKSTRUCT *info = reinterpret_cast< const KBDLLHOOKSTRUCT * >( lparam );
+        KeyEventSource *target = hook_target.load( std::memory_order_acquire );
+        if ( target )
+            target->OnKey( info->vkCode, wparam == WM_KEYDOWN || wparam == WM_SYSKEYDOWN );
+    }
+    return CallNextHookEx( NULL, code, wparam, lparam );
+}
+
+
+KeyEventSource::KeyEventSource()
+    : thread_id_( 0 ), running_( false ), mismatched_( false ), transitions_( 0 ), seen_( 0 ), woken_( false )
+{
+}
+
+
+KeyEventSource::~KeyEventSource()
+{
+    Stop();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Install the hook, returns false if events aren't available
+//-----------------------------------------------------------------------------
+bool KeyEventSource::Start()
+{
+    if ( running_ )
+        return true;
+
+    KeyEventSource *expected = nullptr;
+    if ( !hook_target.compare_exchange_strong( expected, this ) )
+    {
+        DriverLog( "Keyboard hook already in use, polling hotkeys\n" );
+        return false;
+    }
+
+    // Start from the keys already down, the hook only reports changes
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        down_.reset();
+        for ( uint32_t key = 1; key < down_.size(); key++ )
+        {
+            if ( GetAsyncKeyState( key ) & 0x8000 )
+                down_.set( key );
+        }
+    }
+    mismatched_ = false;
+
+    std::promise< bool > started;
+    std::future< bool > result = started.get_future();
+    thread_ = std::thread( [ this, &started ]() {
+        MSG msg;
+        // Create the message queue before anyone can post WM_QUIT to it
+        PeekMessage( &msg, NULL, WM_USER, WM_USER, PM_NOREMOVE );
+        thread_id_ = GetCurrentThreadId();
+
+        HHOOK hook = SetWindowsHookEx( WH_KEYBOARD_LL, LowLevelKeyboardProc, GetModuleHandle( NULL ), 0 );
+        started.set_value( hook != NULL );
+        if ( hook == NULL )
+            return;
+
+        HookThread();
+        UnhookWindowsHookEx( hook );
+    } );
+
+    running_ = result.get();
+    if ( !running_ )
+    {
+        DriverLog( "Failed to install keyboard hook: %d, polling hotkeys\n", GetLastError() );
+        thread_.join();
+        hook_target = nullptr;
+    }
+    return running_;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Remove the hook and release any waiter
+//-----------------------------------------------------------------------------
+void KeyEventSource::Stop()
+{
+    if ( running_.exchange( false ) )
+    {
+        PostThreadMessage( thread_id_, WM_QUIT, 0, 0 );
+        thread_.join();
+        hook_target = nullptr;
+    }
+    Wake();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Compare keys polled with GetAsyncKeyState() against what the hook
+// reported. If they keep disagreeing the hook has stopped being called, so it
+// is reinstalled. Returns true if it was.
+//-----------------------------------------------------------------------------
+bool KeyEventSource::CheckHook( const KeySet &polled, const KeySet &keys, std::chrono::steady_clock::time_point now )
+{
+    if ( !running_ )
+        return false;
+
+    bool agree;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        agree = ( ( down_ ^ polled ) & keys ).none();
+    }
+    if ( agree )
+    {
+        mismatched_ = false;
+        return false;
+    }
+    if ( !mismatched_ )
+    {
+        mismatched_ = true;
+        mismatch_since_ = now;
+        return false;
+    }
+    if ( now - mismatch_since_ < k_hook_grace )
+        return false;
+
+    DriverLog( "Keyboard hook stopped receiving events, reinstalling it\n" );
+    Stop();
+    return Start();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Block until a key transition, Wake() or the timeout. Returns true
+// if a transition arrived since the previous call.
+//-----------------------------------------------------------------------------
+bool KeyEventSource::WaitForTransition( std::chrono::milliseconds timeout )
+{
+    if ( !running_ )
+    {
+        std::this_thread::sleep_for( timeout );
+        return false;
+    }
+
+    std::unique_lock< std::mutex > lock( mutex_ );
+    cv_.wait_for( lock, timeout, [ this ]() { return transitions_ != seen_ || woken_; } );
+    woken_ = false;
+    bool transitioned = transitions_ != seen_;
+    seen_ = transitions_;
+    return transitioned;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Release a waiter without a key event, e.g. on shutdown
+//-----------------------------------------------------------------------------
+void KeyEventSource::Wake()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        woken_ = true;
+    }
+    cv_.notify_all();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Record a key event, only real transitions wake the waiter so
+// auto-repeat of a held key doesn't
+//-----------------------------------------------------------------------------
+void KeyEventSource::OnKey( uint32_t key, bool down )
+{
+    if ( key >= down_.size() || down_.test( key ) == down )
+        return;
+
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        down_.set( key, down );
+        for ( const auto &modifier : k_modifiers )
+        {
+            if ( key == modifier.left || key == modifier.right )
+                down_.set( modifier.generic, down_.test( modifier.left ) || down_.test( modifier.right ) );
+        }
+        transitions_++;
+    }
+    cv_.notify_all();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Pump messages so the hook gets called, until WM_QUIT
+//-----------------------------------------------------------------------------
+void KeyEventSource::HookThread()
+{
+    MSG msg;
+    while ( GetMessage( &msg, NULL, 0, 0 ) > 0 )
+    {
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "key_bindings.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Wakes the hotkey thread on keyboard transitions. A low-level
+// keyboard hook runs on its own message loop thread and signals every key
+// press or release, so an idle hotkey thread can block instead of waking
+// every frame. If the hook can't be installed Start() returns false and the
+// caller keeps polling; WaitForTransition() then just sleeps.
+// Windows silently removes a hook whose callback overruns LowLevelHooksTimeout,
+// so the caller should keep polling now and then and hand the result to
+// CheckHook(), which reinstalls the hook once the two disagree.
+//-----------------------------------------------------------------------------
+class KeyEventSource
+{
+public:
+    KeyEventSource();
+    ~KeyEventSource();
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return running_; }
+    bool CheckHook( const KeySet &polled, const KeySet &keys, std::chrono::steady_clock::time_point now );
+
+    bool WaitForTransition( std::chrono::milliseconds timeout );
+    void Wake();
+
+    // Called from the hook thread for every key event
+    void OnKey( uint32_t key, bool down );
+
+private:
+    void HookThread();
+
+    std::thread thread_;
+    std::atomic< uint32_t > thread_id_;
+    std::atomic< bool > running_;
+
+    // Keys the hook has seen go down, written by the hook thread under mutex_
+    KeySet down_;
+
+    // Since when a poll has disagreed with down_, only touched by CheckHook()
+    bool mismatched_;
+    std::chrono::steady_clock::time_point mismatch_since_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t transitions_;
+    uint64_t seen_;
+    bool woken_;
+};
@@ -0,0 +1,151 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "notifier.h"
+#include "driverlog.h"
+
+
+Notifier::Notifier()
+    : pending_( 0 ), running_( false ), stats_{ 0, 0, 0 }
+{
+}
+
+
+Notifier::~Notifier()
+{
+    Stop();
+}
+
+
+void Notifier::AddSink( std::unique_ptr< INotifySink > sink )
+{
+    sinks_.push_back( std::move( sink ) );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Start the notifier thread
+//-----------------------------------------------------------------------------
+void Notifier::Start()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if ( running_ )
+        return;
+    running_ = true;
+    pending_ = 0;
+    thread_ = std::thread( &Notifier::WorkerThread, this );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Stop the notifier thread, cues still queued are dropped
+//-----------------------------------------------------------------------------
+void Notifier::Stop()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( !running_ )
+            return;
+        running_ = false;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Queue a cue and return immediately, safe from any thread
+//-----------------------------------------------------------------------------
+void Notifier::Post( NotifyCue cue )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( !running_ )
+            return;
+        stats_.posted++;
+        uint32_t bit = 1u << cue;
+        if ( pending_ & bit )
+        {
+            stats_.coalesced++;
+            return;
+        }
+        pending_ |= bit;
+    }
+    cv_.notify_one();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Play queued cues on every sink, outside the lock
+//-----------------------------------------------------------------------------
+void Notifier::WorkerThread()
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    while ( true )
+    {
+        cv_.wait( lock, [ this ] { return pending_ != 0 || !running_; } );
+        if ( !running_ )
+            break;
+
+        uint32_t cues = pending_;
+        pending_ = 0;
+        lock.unlock();
+
+        uint64_t played = 0;
+        for ( uint32_t cue = 0; cue < NOTIFY_CUE_COUNT; cue++ )
+        {
+            if ( !( cues & ( 1u << cue ) ) )
+                continue;
+            for ( auto &sink : sinks_ )
+                sink->Play( ( NotifyCue )cue );
+            played++;
+        }
+
+        lock.lock();
+        stats_.played += played;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: How many cues were posted, merged and played
+//-----------------------------------------------------------------------------
+Notifier::Stats Notifier::GetStats() const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    return stats_;
+}
+
+
+void Notifier::LogStats( const char *name ) const
+{
+    Stats stats = GetStats();
+    DriverLog( "%s notifications: %llu posted, %llu played, %llu coalesced\n", name,
+        ( unsigned long long )stats.posted, ( unsigned long long )stats.played, ( unsigned long long )stats.coalesced );
+}
+
+
+void LogSink::Play( NotifyCue cue )
+{
+    switch ( cue )
+    {
+    case NOTIFY_SUCCESS:
+        DriverLog( "Notify: success\n" );
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// User feedback cues
+enum NotifyCue : uint32_t
+{
+    NOTIFY_SUCCESS = 0,
+    NOTIFY_CUE_COUNT
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: One way of presenting a cue. Play() runs on the notifier thread
+// and may block for as long as the cue lasts.
+//-----------------------------------------------------------------------------
+class INotifySink
+{
+public:
+    virtual ~INotifySink() = default;
+
+    virtual void Play( NotifyCue cue ) = 0;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Plays cues on its own thread so Post() never blocks the caller.
+// A cue posted again before it has started playing is only played once.
+//-----------------------------------------------------------------------------
+class Notifier
+{
+public:
+    Notifier();
+    ~Notifier();
+
+    // Sinks must be added before Start()
+    void AddSink( std::unique_ptr< INotifySink > sink );
+    void Start();
+    void Stop();
+
+    void Post( NotifyCue cue );
+
+    struct Stats
+    {
+        uint64_t posted;
+        uint64_t coalesced;
+        uint64_t played;
+    };
+    Stats GetStats() const;
+    void LogStats( const char *name ) const;
+
+private:
+    void WorkerThread();
+
+    std::vector< std::unique_ptr< INotifySink > > sinks_;
+    std::thread thread_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t pending_; // bit per NotifyCue
+    bool running_;
+
+    Stats stats_;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Driver log line per cue
+//-----------------------------------------------------------------------------
+class LogSink : public INotifySink
+{
+public:
+    void Play( NotifyCue cue ) override;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Drops every cue
+//-----------------------------------------------------------------------------
+class NullSink : public INotifySink
+{
+public:
+    void Play( NotifyCue ) override {}
+};
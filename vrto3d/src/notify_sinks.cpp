@@ -0,0 +1,56 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "notify_sinks.h"
+
+#include <chrono>
+#include <thread>
+
+#include <windows.h>
+#include <xinput.h>
+
+
+void ToneSink::Play( NotifyCue cue )
+{
+    switch ( cue )
+    {
+    case NOTIFY_SUCCESS:
+        // High beep for success
+        Beep( 1800, 400 );
+        break;
+    default:
+        break;
+    }
+}
+
+
+void XInputRumbleSink::Play( NotifyCue cue )
+{
+    if ( cue != NOTIFY_SUCCESS )
+        return;
+
+    XINPUT_VIBRATION vibration = { 30000, 30000 };
+    bool rumbling[ XUSER_MAX_COUNT ] = {};
+    for ( DWORD slot = 0; slot < XUSER_MAX_COUNT; slot++ )
+        rumbling[ slot ] = XInputSetState( slot, &vibration ) == ERROR_SUCCESS;
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+
+    vibration = { 0, 0 };
+    for ( DWORD slot = 0; slot < XUSER_MAX_COUNT; slot++ )
+        if ( rumbling[ slot ] )
+            XInputSetState( slot, &vibration );
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pose_derivatives.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+PoseDerivativeEstimator::PoseDerivativeEstimator( float time_constant, float min_dt, float max_dt )
+    : time_constant_( time_constant ), min_dt_( min_dt ), max_dt_( max_dt )
+{
+    Reset();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Forget the history, used when the pose jumps (e.g. on reset)
+//-----------------------------------------------------------------------------
+void PoseDerivativeEstimator::Reset()
+{
+    primed_ = false;
+    for ( int i = 0; i < 3; i++ )
+    {
+        last_position_[ i ] = 0.0;
+        velocity_[ i ] = 0.0;
+        acceleration_[ i ] = 0.0;
+        angular_velocity_[ i ] = 0.0;
+        angular_acceleration_[ i ] = 0.0;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Update the derivatives from the new pose position. dt is the time
+// since the previous update in seconds, pitch_rate and yaw_rate are the
+// angular rates in radians per second.
+//-----------------------------------------------------------------------------
+void PoseDerivativeEstimator::Update( vr::DriverPose_t &pose, float dt, double pitch_rate, double yaw_rate )
+{
+    // A stalled or back-to-back tick would blow up a plain finite difference
+    dt = std::clamp( dt, min_dt_, max_dt_ );
+
+    const double angular_rate[ 3 ] = { pitch_rate, yaw_rate, 0.0 };
+    for ( int i = 0; i < 3; i++ )
+    {
+        if ( primed_ )
+        {
+            double velocity = ( pose.vecPosition[ i ] - last_position_[ i ] ) / dt;
+            double last_velocity = velocity_[ i ];
+            Filter( dt, velocity, velocity_[ i ] );
+            Filter( dt, ( velocity_[ i ] - last_velocity ) / dt, acceleration_[ i ] );
+            Filter( dt, ( angular_rate[ i ] - angular_velocity_[ i ] ) / dt, angular_acceleration_[ i ] );
+        }
+        last_position_[ i ] = pose.vecPosition[ i ];
+        angular_velocity_[ i ] = angular_rate[ i ];
+
+        pose.vecVelocity[ i ] = velocity_[ i ];
+        pose.vecAcceleration[ i ] = acceleration_[ i ];
+        pose.vecAngularVelocity[ i ] = angular_velocity_[ i ];
+        pose.vecAngularAcceleration[ i ] = angular_acceleration_[ i ];
+    }
+    primed_ = true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: One step of an exponential filter whose weight follows dt, so the
+// response is the same whatever the tick length
+//-----------------------------------------------------------------------------
+void PoseDerivativeEstimator::Filter( float dt, double sample, double &state ) const
+{
+    double alpha = time_constant_ > 0.0f ? 1.0 - std::exp( -dt / time_constant_ ) : 1.0;
+    state += alpha * ( sample - state );
+
+    // Settle to exactly zero so a static pose compares equal tick to tick
+    if ( std::abs( state ) < 1e-6 )
+        state = 0.0;
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <openvr_driver.h>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills in the velocity and acceleration fields of a pose. Angular
+// velocity comes straight from the stick driven pitch & yaw rates, linear
+// terms are differenced from the position and low-pass filtered with a time
+// constant, so a short tick after an oversleep doesn't make them spike.
+// SteamVR's reprojection extrapolates from these fields.
+//-----------------------------------------------------------------------------
+class PoseDerivativeEstimator
+{
+public:
+    PoseDerivativeEstimator( float time_constant, float min_dt, float max_dt );
+
+    void Reset();
+    void Update( vr::DriverPose_t &pose, float dt, double pitch_rate, double yaw_rate );
+
+private:
+    void Filter( float dt, double sample, double &state ) const;
+
+    float time_constant_;
+    float min_dt_;
+    float max_dt_;
+
+    bool primed_;
+    double last_position_[ 3 ];
+    double velocity_[ 3 ];
+    double acceleration_[ 3 ];
+    double angular_velocity_[ 3 ];
+    double angular_acceleration_[ 3 ];
+};
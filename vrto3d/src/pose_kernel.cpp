@@ -0,0 +1,48 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pose_kernel.h"
+
+
+double WrapDegrees(double degrees)
+{
+    return std::remainder(degrees, 360.0);
+}
+
+
+void ComputeHeadPose(double pitch, double yaw, double radius, double height, vr::HmdQuaternion_t& rotation, double position[3])
+{
+    double sp, cp, sy, cy;
+    SinCos(0.5 * pitch, sp, cp);
+    SinCos(0.5 * yaw, sy, cy);
+
+    // Yaw about +Y followed by pitch about +X
+    rotation.w = cy * cp;
+    rotation.x = cy * sp;
+    rotation.y = sy * cp;
+    rotation.z = -sy * sp;
+
+    double sinPitch = 2.0 * sp * cp;
+    double sinYaw = 2.0 * sy * cy;
+    double cosYaw = 1.0 - 2.0 * sy * sy;
+
+    // radius * (cos(pitch) - 1) without the cancellation near zero pitch
+    double orbit = -2.0 * radius * sp * sp;
+
+    position[0] = orbit * sinYaw;
+    position[1] = height - radius * sinPitch;
+    position[2] = orbit * cosYaw;
+}
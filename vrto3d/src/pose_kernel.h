@@ -0,0 +1,48 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cmath>
+#include <openvr_driver.h>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Wrap an angle in degrees to [-180, 180]. Yaw is accumulated as a
+// wrapped scalar instead of a repeatedly renormalized quaternion, so it
+// doesn't drift however long the stick is held.
+//-----------------------------------------------------------------------------
+double WrapDegrees(double degrees);
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Sine and cosine of the same angle in one call
+//-----------------------------------------------------------------------------
+inline void SinCos(double radians, double& s, double& c)
+{
+    // Kept side by side so the compiler can fuse them into a single sincos
+    s = std::sin(radians);
+    c = std::cos(radians);
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Closed-form HMD rotation and orbit position for a pitch & yaw in
+// radians. The rotation is yaw * pitch built directly from the half angles,
+// which is unit length by construction, and the full angles come from the
+// double-angle identities, so the whole pose costs two sincos calls.
+//-----------------------------------------------------------------------------
+void ComputeHeadPose(double pitch, double yaw, double radius, double height, vr::HmdQuaternion_t& rotation, double position[3]);
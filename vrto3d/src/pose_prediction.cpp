@@ -0,0 +1,38 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pose_prediction.h"
+
+#include <cmath>
+
+
+double PredictAngleOffset(int model, double rate, double horizon, double time_constant)
+{
+    if (horizon <= 0.0 || rate == 0.0)
+        return 0.0;
+
+    switch (model)
+    {
+    case PREDICT_CONSTANT:
+        return rate * horizon;
+    case PREDICT_DAMPED:
+        if (time_constant <= 0.0)
+            return 0.0;
+        return rate * time_constant * (1.0 - std::exp(-horizon / time_constant));
+    default:
+        return 0.0;
+    }
+}
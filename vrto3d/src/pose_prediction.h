@@ -0,0 +1,40 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+// Pose Prediction Models
+#define PREDICT_NONE     0
+#define PREDICT_CONSTANT 1
+#define PREDICT_DAMPED   2
+static std::unordered_map<std::string, int> PredictionModels = {
+    {"none", PREDICT_NONE},
+    {"constant", PREDICT_CONSTANT},
+    {"damped", PREDICT_DAMPED}
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: How far an angle moving at rate (units/s) will have travelled
+// after horizon seconds under the given prediction model.
+// Constant velocity assumes the stick stays where it is. Damped assumes the
+// rate decays exponentially with time_constant, which overshoots less when
+// the stick is released.
+//-----------------------------------------------------------------------------
+double PredictAngleOffset(int model, double rate, double horizon, double time_constant);
@@ -0,0 +1,96 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pose_submit_gate.h"
+#include "driverlog.h"
+
+#include <cstring>
+
+
+PoseSubmitGate::PoseSubmitGate()
+    : last_pose_{}, has_last_( false ), changed_( 0 ), keep_alive_( 0 ), skipped_( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the pose should be submitted this tick, a keep-alive
+// rate of 0 or less submits every pose
+//-----------------------------------------------------------------------------
+bool PoseSubmitGate::ShouldSubmit( const vr::DriverPose_t &pose, Clock::time_point now, float keep_alive_hz )
+{
+    if ( !has_last_ || !SamePose( pose, last_pose_ ) )
+    {
+        changed_++;
+    }
+    else if ( keep_alive_hz <= 0.0f ||
+        now - last_submit_ >= std::chrono::duration_cast< Clock::duration >( std::chrono::duration< float >( 1.0f / keep_alive_hz ) ) )
+    {
+        keep_alive_++;
+    }
+    else
+    {
+        skipped_++;
+        return false;
+    }
+
+    last_pose_ = pose;
+    last_submit_ = now;
+    has_last_ = true;
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Log how many poses were sent and how many were skipped
+//-----------------------------------------------------------------------------
+void PoseSubmitGate::LogStats( const char *name ) const
+{
+    uint64_t total = changed_ + keep_alive_ + skipped_;
+    if ( total == 0 )
+        return;
+
+    DriverLog( "%s submits: %llu changed, %llu keep-alive, %llu skipped (%.1f%% of %llu)\n",
+        name, ( unsigned long long )changed_, ( unsigned long long )keep_alive_, ( unsigned long long )skipped_,
+        100.0 * ( double )skipped_ / ( double )total, ( unsigned long long )total );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Field-wise comparison of everything vrserver consumes, memcmp over
+// the whole struct would also compare padding
+//-----------------------------------------------------------------------------
+bool PoseSubmitGate::SamePose( const vr::DriverPose_t &a, const vr::DriverPose_t &b )
+{
+    auto same = []( const auto &x, const auto &y ) { return std::memcmp( &x, &y, sizeof( x ) ) == 0; };
+
+    return same( a.vecPosition, b.vecPosition ) &&
+        same( a.vecVelocity, b.vecVelocity ) &&
+        same( a.vecAcceleration, b.vecAcceleration ) &&
+        same( a.qRotation, b.qRotation ) &&
+        same( a.vecAngularVelocity, b.vecAngularVelocity ) &&
+        same( a.vecAngularAcceleration, b.vecAngularAcceleration ) &&
+        same( a.qWorldFromDriverRotation, b.qWorldFromDriverRotation ) &&
+        same( a.vecWorldFromDriverTranslation, b.vecWorldFromDriverTranslation ) &&
+        same( a.qDriverFromHeadRotation, b.qDriverFromHeadRotation ) &&
+        same( a.vecDriverFromHeadTranslation, b.vecDriverFromHeadTranslation ) &&
+        a.poseTimeOffset == b.poseTimeOffset &&
+        a.result == b.result &&
+        a.poseIsValid == b.poseIsValid &&
+        a.willDriftInYaw == b.willDriftInYaw &&
+        a.shouldApplyHeadModel == b.shouldApplyHeadModel &&
+        a.deviceIsConnected == b.deviceIsConnected;
+}
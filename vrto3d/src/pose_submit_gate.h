@@ -0,0 +1,51 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <openvr_driver.h>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Decides whether a pose needs to be sent to vrserver. Any change is
+// submitted straight away, an unchanged pose is only resent as a keep-alive
+// at a minimum rate, which saves the IPC round trip and vrserver wake-up in
+// games where the HMD never moves.
+//-----------------------------------------------------------------------------
+class PoseSubmitGate
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PoseSubmitGate();
+
+    bool ShouldSubmit( const vr::DriverPose_t &pose, Clock::time_point now, float keep_alive_hz );
+    void LogStats( const char *name ) const;
+
+private:
+    static bool SamePose( const vr::DriverPose_t &a, const vr::DriverPose_t &b );
+
+    vr::DriverPose_t last_pose_;
+    Clock::time_point last_submit_;
+    bool has_last_;
+
+    uint64_t changed_;
+    uint64_t keep_alive_;
+    uint64_t skipped_;
+};
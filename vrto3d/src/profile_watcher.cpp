@@ -0,0 +1,169 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "profile_watcher.h"
+#include "driverlog.h"
+
+#include <chrono>
+#include <set>
+
+#include <windows.h>
+
+
+// How long a file has to stay untouched before it is reported
+static constexpr DWORD k_settle_ms = 250;
+
+
+ProfileWatcher::ProfileWatcher()
+    : running_( false ), dir_handle_( INVALID_HANDLE_VALUE ), stop_event_( NULL )
+{
+}
+
+
+ProfileWatcher::~ProfileWatcher()
+{
+    Stop();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Start watching folder, returns false if it can't be watched
+//-----------------------------------------------------------------------------
+bool ProfileWatcher::Start( const std::string &folder, Callback callback )
+{
+    if ( running_ )
+        return true;
+
+    dir_handle_ = CreateFileA( folder.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL );
+    if ( dir_handle_ == INVALID_HANDLE_VALUE )
+    {
+        DriverLog( "Failed to watch %s: %d, profile edits need Ctrl+F10\n", folder.c_str(), GetLastError() );
+        return false;
+    }
+
+    stop_event_ = CreateEvent( NULL, TRUE, FALSE, NULL );
+    folder_ = folder;
+    callback_ = std::move( callback );
+    running_ = true;
+    thread_ = std::thread( &ProfileWatcher::WatchThread, this );
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Stop watching, pending unsettled files are dropped
+//-----------------------------------------------------------------------------
+void ProfileWatcher::Stop()
+{
+    if ( !running_.exchange( false ) )
+        return;
+
+    SetEvent( stop_event_ );
+    thread_.join();
+    CloseHandle( stop_event_ );
+    CloseHandle( dir_handle_ );
+    stop_event_ = NULL;
+    dir_handle_ = INVALID_HANDLE_VALUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Keep one directory read in flight and report files once settled
+//-----------------------------------------------------------------------------
+void ProfileWatcher::WatchThread()
+{
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
+    alignas( DWORD ) char buffer[ 16 * 1024 ];
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+    std::set< std::string > changed;
+    auto last_change = std::chrono::steady_clock::now();
+    bool reading = false;
+
+    while ( true )
+    {
+        if ( !reading )
+        {
+            ResetEvent( overlapped.hEvent );
+            if ( !ReadDirectoryChangesW( dir_handle_, buffer, sizeof( buffer ), FALSE, filter, NULL, &overlapped, NULL ) )
+            {
+                DriverLog( "Stopped watching %s: %d\n", folder_.c_str(), GetLastError() );
+                break;
+            }
+            reading = true;
+        }
+
+        DWORD timeout = INFINITE;
+        if ( !changed.empty() )
+        {
+            auto quiet = std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now() - last_change ).count();
+            timeout = quiet >= k_settle_ms ? 0 : k_settle_ms - ( DWORD )quiet;
+        }
+
+        HANDLE handles[ 2 ] = { overlapped.hEvent, stop_event_ };
+        DWORD wait = WaitForMultipleObjects( 2, handles, FALSE, timeout );
+        if ( wait == WAIT_OBJECT_0 + 1 )
+            break;
+
+        if ( wait == WAIT_TIMEOUT )
+        {
+            for ( const auto &file_name : changed )
+                callback_( file_name );
+            changed.clear();
+            continue;
+        }
+
+        DWORD bytes = 0;
+        reading = false;
+        if ( !GetOverlappedResult( dir_handle_, &overlapped, &bytes, FALSE ) )
+            continue;
+
+        // Zero bytes means the buffer overflowed and the events were lost
+        if ( bytes == 0 )
+            DriverLog( "Too many changes in %s, some profile edits were missed\n", folder_.c_str() );
+
+        DWORD offset = 0;
+        while ( bytes != 0 )
+        {
+            const FILE_NOTIFY_INFORMATION *info = reinterpret_cast< const FILE_NOTIFY_INFORMATION * >( buffer + offset );
+            if ( info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME )
+            {
+                int length = ( int )( info->FileNameLength / sizeof( wchar_t ) );
+                char name[ MAX_PATH ];
+                int size = WideCharToMultiByte( CP_UTF8, 0, info->FileName, length, name, sizeof( name ) - 1, NULL, NULL );
+                if ( size > 0 )
+                {
+                    changed.emplace( name, size );
+                    last_change = std::chrono::steady_clock::now();
+                }
+            }
+            if ( info->NextEntryOffset == 0 )
+                break;
+            offset += info->NextEntryOffset;
+        }
+    }
+
+    // Let the kernel finish with buffer before it goes out of scope
+    if ( reading )
+    {
+        DWORD bytes = 0;
+        CancelIoEx( dir_handle_, &overlapped );
+        GetOverlappedResult( dir_handle_, &overlapped, &bytes, TRUE );
+    }
+    CloseHandle( overlapped.hEvent );
+}
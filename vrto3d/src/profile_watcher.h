@@ -0,0 +1,53 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Watches the profile folder and reports files that were written,
+// created or renamed into place. Editors often save in several steps, so a
+// file is only reported once it has been quiet for a short settle time.
+// The callback runs on the watcher thread.
+//-----------------------------------------------------------------------------
+class ProfileWatcher
+{
+public:
+    using Callback = std::function< void( const std::string &file_name ) >;
+
+    ProfileWatcher();
+    ~ProfileWatcher();
+
+    bool Start( const std::string &folder, Callback callback );
+    void Stop();
+
+private:
+    void WatchThread();
+
+    std::string folder_;
+    Callback callback_;
+    std::thread thread_;
+    std::atomic< bool > running_;
+
+    // Windows HANDLEs, kept opaque to stay out of windows.h
+    void *dir_handle_;
+    void *stop_event_;
+};
@@ -0,0 +1,128 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "profile_writer.h"
+#include "driverlog.h"
+
+
+ProfileWriter::ProfileWriter( JsonManager &json_manager )
+    : json_manager_( json_manager ), running_( false ), queued_( 0 ), coalesced_( 0 ), written_( 0 ), failed_( 0 )
+{
+}
+
+
+ProfileWriter::~ProfileWriter()
+{
+    Stop();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Start the writer thread
+//-----------------------------------------------------------------------------
+void ProfileWriter::Start( Callback on_saved )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if ( running_ )
+        return;
+    on_saved_ = std::move( on_saved );
+    running_ = true;
+    thread_ = std::thread( &ProfileWriter::WriterThread, this );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Write anything still queued, then stop the writer thread
+//-----------------------------------------------------------------------------
+void ProfileWriter::Stop()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( !running_ )
+            return;
+        running_ = false;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Queue a save and return immediately
+//-----------------------------------------------------------------------------
+void ProfileWriter::Queue( const std::string &file_name, const StereoDisplayDriverConfiguration &config )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( !running_ )
+        {
+            DriverLog( "Profile writer stopped, %s not saved\n", file_name.c_str() );
+            return;
+        }
+        queued_++;
+        auto result = pending_.insert_or_assign( file_name, config );
+        if ( !result.second )
+            coalesced_++;
+    }
+    cv_.notify_one();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Take every queued save and write them outside the lock
+//-----------------------------------------------------------------------------
+void ProfileWriter::WriterThread()
+{
+    std::unique_lock< std::mutex > lock( mutex_ );
+    while ( true )
+    {
+        cv_.wait( lock, [ this ] { return !pending_.empty() || !running_; } );
+        if ( pending_.empty() )
+            break;
+
+        std::map< std::string, StereoDisplayDriverConfiguration > batch;
+        batch.swap( pending_ );
+        lock.unlock();
+
+        for ( const auto &save : batch )
+        {
+            bool saved = json_manager_.SaveProfileToJson( save.first, save.second );
+            if ( on_saved_ )
+                on_saved_( save.first, saved );
+
+            lock.lock();
+            if ( saved )
+                written_++;
+            else
+                failed_++;
+            lock.unlock();
+        }
+
+        lock.lock();
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Log how many saves were requested and how many hit the disk
+//-----------------------------------------------------------------------------
+void ProfileWriter::LogStats( const char *name ) const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    DriverLog( "%s profile saves: %llu queued, %llu written, %llu coalesced, %llu failed\n", name,
+        ( unsigned long long )queued_, ( unsigned long long )written_, ( unsigned long long )coalesced_,
+        ( unsigned long long )failed_ );
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "json_manager.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Saves profiles on a background thread so the hotkey thread never
+// waits on the disk. Saves queued for the same file before the writer gets
+// to them collapse into one write of the newest settings.
+//-----------------------------------------------------------------------------
+class ProfileWriter
+{
+public:
+    // Called on the writer thread once a file has been saved or failed to
+    using Callback = std::function< void( const std::string &file_name, bool saved ) >;
+
+    explicit ProfileWriter( JsonManager &json_manager );
+    ~ProfileWriter();
+
+    void Start( Callback on_saved );
+    void Stop();
+
+    void Queue( const std::string &file_name, const StereoDisplayDriverConfiguration &config );
+    void LogStats( const char *name ) const;
+
+private:
+    void WriterThread();
+
+    JsonManager &json_manager_;
+    Callback on_saved_;
+    std::thread thread_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map< std::string, StereoDisplayDriverConfiguration > pending_;
+    bool running_;
+
+    uint64_t queued_;
+    uint64_t coalesced_;
+    uint64_t written_;
+    uint64_t failed_;
+};
@@ -0,0 +1,249 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "property_writer.h"
+#include "driverlog.h"
+
+#include <cstring>
+
+
+PropertyWriter::PropertyWriter()
+    : device_index_( vr::k_unTrackedDeviceIndexInvalid ), container_( vr::k_ulInvalidPropertyContainer ),
+    requested_( 0 ), unchanged_( 0 ), coalesced_( 0 ), written_count_( 0 ), batches_( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Queue a float property, sent on the next Flush() if it changed
+//-----------------------------------------------------------------------------
+void PropertyWriter::SetFloat( uint32_t device_index, vr::ETrackedDeviceProperty prop, float value )
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    requested_++;
+
+    // Resolve the container once per device rather than on every write
+    if ( device_index != device_index_ )
+    {
+        device_index_ = device_index;
+        container_ = vr::VRProperties()->TrackedDeviceToPropertyContainer( device_index );
+        written_.clear();
+        pending_.clear();
+    }
+
+    auto pending = pending_.find( prop );
+    auto written = written_.find( prop );
+    if ( written != written_.end() && written->second == value )
+    {
+        // Back to the value vrserver already has, drop anything queued
+        if ( pending != pending_.end() )
+        {
+            pending_.erase( pending );
+            coalesced_++;
+        }
+        unchanged_++;
+        return;
+    }
+
+    if ( pending != pending_.end() )
+    {
+        pending->second = value;
+        coalesced_++;
+    }
+    else
+    {
+        pending_.emplace( prop, value );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Send every queued property in one batch
+//-----------------------------------------------------------------------------
+void PropertyWriter::Flush()
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    if ( pending_.empty() )
+        return;
+
+    // Values must stay alive until the batch call returns
+    std::vector< float > values;
+    std::vector< vr::PropertyWrite_t > batch;
+    values.reserve( pending_.size() );
+    batch.reserve( pending_.size() );
+    for ( const auto &entry : pending_ )
+    {
+        values.push_back( entry.second );
+
+        vr::PropertyWrite_t write = {};
+        write.prop = entry.first;
+        write.writeType = vr::PropertyWrite_Set;
+        write.pvBuffer = &values.back();
+        write.unBufferSize = sizeof( float );
+        write.unTag = vr::k_unFloatPropertyTag;
+        batch.push_back( write );
+    }
+
+    vr::ETrackedPropertyError error = vr::VRProperties()->WritePropertyBatch( container_, batch.data(), ( uint32_t )batch.size() );
+    batches_++;
+    for ( const auto &write : batch )
+    {
+        if ( write.eError != vr::TrackedProp_Success )
+        {
+            // Leave it out of written_ so the next identical request retries
+            DriverLog( "Failed to write property %d: %d\n", write.prop, write.eError );
+            continue;
+        }
+        written_[ write.prop ] = *( const float * )write.pvBuffer;
+        written_count_++;
+    }
+    if ( error != vr::TrackedProp_Success )
+        DriverLog( "Property batch returned %d\n", error );
+    pending_.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Log how many property writes were actually sent vs skipped
+//-----------------------------------------------------------------------------
+void PropertyWriter::LogStats( const char *name ) const
+{
+    std::lock_guard< std::mutex > lock( mutex_ );
+    DriverLog( "%s property writes: %llu requested, %llu written in %llu batches, %llu unchanged, %llu coalesced\n",
+        name, ( unsigned long long )requested_, ( unsigned long long )written_count_, ( unsigned long long )batches_,
+        ( unsigned long long )unchanged_, ( unsigned long long )coalesced_ );
+}
+
+
+void PropertyBatch::SetBool( vr::ETrackedDeviceProperty prop, bool value )
+{
+    AddScalar( prop, vr::k_unBoolPropertyTag, &value, sizeof( value ) );
+}
+
+
+void PropertyBatch::SetFloat( vr::ETrackedDeviceProperty prop, float value )
+{
+    AddScalar( prop, vr::k_unFloatPropertyTag, &value, sizeof( value ) );
+}
+
+
+void PropertyBatch::SetInt32( vr::ETrackedDeviceProperty prop, int32_t value )
+{
+    AddScalar( prop, vr::k_unInt32PropertyTag, &value, sizeof( value ) );
+}
+
+
+void PropertyBatch::SetUint64( vr::ETrackedDeviceProperty prop, uint64_t value )
+{
+    AddScalar( prop, vr::k_unUint64PropertyTag, &value, sizeof( value ) );
+}
+
+
+void PropertyBatch::SetString( vr::ETrackedDeviceProperty prop, std::string value )
+{
+    entries_.push_back( { prop, vr::k_unStringPropertyTag, 0, std::move( value ) } );
+}
+
+
+void PropertyBatch::AddScalar( vr::ETrackedDeviceProperty prop, vr::PropertyTypeTag_t tag, const void *value, size_t size )
+{
+    Entry entry = { prop, tag, 0, {} };
+    memcpy( &entry.scalar, value, size );
+    entries_.push_back( std::move( entry ) );
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Send every property in one call, returns how many were set
+//-----------------------------------------------------------------------------
+uint32_t PropertyBatch::Write( vr::PropertyContainerHandle_t container )
+{
+    if ( entries_.empty() )
+        return 0;
+
+    std::vector< vr::PropertyWrite_t > batch;
+    batch.reserve( entries_.size() );
+    for ( auto &entry : entries_ )
+    {
+        vr::PropertyWrite_t write = {};
+        write.prop = entry.prop;
+        write.writeType = vr::PropertyWrite_Set;
+        write.unTag = entry.tag;
+        if ( entry.tag == vr::k_unStringPropertyTag )
+        {
+            write.pvBuffer = entry.text.data();
+            write.unBufferSize = ( uint32_t )entry.text.size() + 1;
+        }
+        else
+        {
+            write.pvBuffer = &entry.scalar;
+            write.unBufferSize = entry.tag == vr::k_unUint64PropertyTag ? sizeof( uint64_t ) :
+                entry.tag == vr::k_unBoolPropertyTag ? sizeof( bool ) : sizeof( uint32_t );
+        }
+        batch.push_back( write );
+    }
+
+    vr::ETrackedPropertyError error = vr::VRProperties()->WritePropertyBatch( container, batch.data(), ( uint32_t )batch.size() );
+    if ( error != vr::TrackedProp_Success )
+        DriverLog( "Property batch returned %d\n", error );
+
+    uint32_t written = 0;
+    for ( const auto &write : batch )
+    {
+        if ( write.eError == vr::TrackedProp_Success )
+            written++;
+        else
+            DriverLog( "Failed to write property %d: %d\n", write.prop, write.eError );
+    }
+    return written;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Only write settings that differ, every SetXxx persists
+// steamvr.vrsettings to disk even if the value didn't change
+//-----------------------------------------------------------------------------
+bool SyncSetting( const char *section, const char *key, bool value )
+{
+    vr::EVRSettingsError error = vr::VRSettingsError_None;
+    bool current = vr::VRSettings()->GetBool( section, key, &error );
+    if ( error == vr::VRSettingsError_None && current == value )
+        return false;
+    vr::VRSettings()->SetBool( section, key, value );
+    return true;
+}
+
+
+bool SyncSetting( const char *section, const char *key, int32_t value )
+{
+    vr::EVRSettingsError error = vr::VRSettingsError_None;
+    int32_t current = vr::VRSettings()->GetInt32( section, key, &error );
+    if ( error == vr::VRSettingsError_None && current == value )
+        return false;
+    vr::VRSettings()->SetInt32( section, key, value );
+    return true;
+}
+
+
+bool SyncSetting( const char *section, const char *key, float value )
+{
+    vr::EVRSettingsError error = vr::VRSettingsError_None;
+    float current = vr::VRSettings()->GetFloat( section, key, &error );
+    if ( error == vr::VRSettingsError_None && current == value )
+        return false;
+    vr::VRSettings()->SetFloat( section, key, value );
+    return true;
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <openvr_driver.h>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Buffers float property writes for one device. Values equal to the
+// last one written are dropped, repeated writes before a flush collapse to
+// the newest value, and Flush() sends what is left as one WritePropertyBatch.
+// Every property write is a cross-process call that vrserver forwards to
+// running apps, so a held hotkey shouldn't cost one per step.
+//-----------------------------------------------------------------------------
+class PropertyWriter
+{
+public:
+    PropertyWriter();
+
+    void SetFloat( uint32_t device_index, vr::ETrackedDeviceProperty prop, float value );
+    void Flush();
+    void LogStats( const char *name ) const;
+
+private:
+    mutable std::mutex mutex_;
+
+    uint32_t device_index_;
+    vr::PropertyContainerHandle_t container_;
+
+    std::map< vr::ETrackedDeviceProperty, float > written_;
+    std::map< vr::ETrackedDeviceProperty, float > pending_;
+
+    uint64_t requested_;
+    uint64_t unchanged_;
+    uint64_t coalesced_;
+    uint64_t written_count_;
+    uint64_t batches_;
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Mixed-type property list sent with a single WritePropertyBatch,
+// for setting up a device in one call instead of one per property
+//-----------------------------------------------------------------------------
+class PropertyBatch
+{
+public:
+    void SetBool( vr::ETrackedDeviceProperty prop, bool value );
+    void SetFloat( vr::ETrackedDeviceProperty prop, float value );
+    void SetInt32( vr::ETrackedDeviceProperty prop, int32_t value );
+    void SetUint64( vr::ETrackedDeviceProperty prop, uint64_t value );
+    void SetString( vr::ETrackedDeviceProperty prop, std::string value );
+
+    uint32_t Write( vr::PropertyContainerHandle_t container );
+    size_t Size() const { return entries_.size(); }
+
+private:
+    struct Entry
+    {
+        vr::ETrackedDeviceProperty prop;
+        vr::PropertyTypeTag_t tag;
+        uint64_t scalar;
+        std::string text;
+    };
+
+    void AddScalar( vr::ETrackedDeviceProperty prop, vr::PropertyTypeTag_t tag, const void *value, size_t size );
+
+    std::vector< Entry > entries_;
+};
+
+
+// Read-compare-write for vrsettings, returns true if the value had to be written
+bool SyncSetting( const char *section, const char *key, bool value );
+bool SyncSetting( const char *section, const char *key, int32_t value );
+bool SyncSetting( const char *section, const char *key, float value );
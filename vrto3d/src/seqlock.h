@@ -0,0 +1,94 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Single writer, multi reader slot for a trivially copyable value.
+// The writer never waits and readers never take a lock; a reader only
+// retries its copy if it overlapped a store. The payload is held in atomic
+// words so the racing copy is well defined.
+//-----------------------------------------------------------------------------
+template < typename T >
+class SeqLock
+{
+    static_assert( std::is_trivially_copyable< T >::value, "SeqLock requires a trivially copyable type" );
+
+public:
+    SeqLock()
+        : seq_( 0 )
+    {
+        for ( auto &word : data_ )
+            word.store( 0, std::memory_order_relaxed );
+    }
+
+    explicit SeqLock( const T &value )
+        : SeqLock()
+    {
+        Store( value );
+    }
+
+    // Must only be called from one thread at a time
+    void Store( const T &value )
+    {
+        uint64_t words[ k_words ] = {};
+        std::memcpy( words, &value, sizeof( T ) );
+
+        uint64_t seq = seq_.load( std::memory_order_relaxed );
+        seq_.store( seq + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        for ( size_t i = 0; i < k_words; i++ )
+            data_[ i ].store( words[ i ], std::memory_order_relaxed );
+        seq_.store( seq + 2, std::memory_order_release );
+    }
+
+    T Load() const
+    {
+        uint64_t words[ k_words ];
+        uint64_t before, after;
+        do
+        {
+            before = seq_.load( std::memory_order_acquire );
+            for ( size_t i = 0; i < k_words; i++ )
+                words[ i ] = data_[ i ].load( std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_acquire );
+            after = seq_.load( std::memory_order_relaxed );
+        } while ( ( before & 1 ) || before != after );
+
+        T value;
+        std::memcpy( &value, words, sizeof( T ) );
+        return value;
+    }
+
+    // Number of completed stores, useful to detect a new value without copying it
+    uint64_t Version() const
+    {
+        return seq_.load( std::memory_order_acquire ) >> 1;
+    }
+
+private:
+    static constexpr size_t k_words = ( sizeof( T ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+    std::atomic< uint64_t > seq_;
+    std::array< std::atomic< uint64_t >, k_words > data_;
+};
@@ -0,0 +1,91 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Publishes immutable snapshots to any number of readers without a
+// lock. Two slots alternate: the writer fills the inactive one and flips the
+// version, readers announce themselves on the slot they are about to copy
+// and retry if the version moved meanwhile. A reader only holds its slot for
+// the shared_ptr copy, the writer waits that long at most before reusing it.
+// std::atomic_load on a shared_ptr would take a hidden global lock instead.
+//-----------------------------------------------------------------------------
+template < typename T >
+class SnapshotSlot
+{
+public:
+    explicit SnapshotSlot( std::shared_ptr< const T > value )
+        : version_( 0 )
+    {
+        slots_[ 0 ].value = std::move( value );
+    }
+
+    SnapshotSlot( const SnapshotSlot & ) = delete;
+    SnapshotSlot &operator=( const SnapshotSlot & ) = delete;
+
+    std::shared_ptr< const T > Load() const
+    {
+        for ( ;; )
+        {
+            uint64_t version = version_.load( std::memory_order_seq_cst );
+            const Slot &slot = slots_[ version & 1 ];
+            slot.readers.fetch_add( 1, std::memory_order_seq_cst );
+            if ( version_.load( std::memory_order_seq_cst ) == version )
+            {
+                std::shared_ptr< const T > value = slot.value;
+                slot.readers.fetch_sub( 1, std::memory_order_release );
+                return value;
+            }
+            // A store moved on while we registered, this slot may be refilled
+            slot.readers.fetch_sub( 1, std::memory_order_release );
+        }
+    }
+
+    // Must only be called from one thread at a time
+    void Store( std::shared_ptr< const T > value )
+    {
+        uint64_t version = version_.load( std::memory_order_relaxed );
+        Slot &next = slots_[ ( version + 1 ) & 1 ];
+        // Readers that picked this slot up before the last store are about to retry
+        while ( next.readers.load( std::memory_order_seq_cst ) != 0 )
+            std::this_thread::yield();
+        next.value = std::move( value );
+        version_.store( version + 1, std::memory_order_seq_cst );
+    }
+
+    // Number of completed stores
+    uint64_t Version() const
+    {
+        return version_.load( std::memory_order_acquire );
+    }
+
+private:
+    struct Slot
+    {
+        std::shared_ptr< const T > value;
+        mutable std::atomic< uint32_t > readers{ 0 };
+    };
+
+    std::atomic< uint64_t > version_;
+    Slot slots_[ 2 ];
+};
@@ -0,0 +1,107 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "xinput_backend.h"
+#include "driverlog.h"
+
+#include <windows.h>
+#include <xinput.h>
+
+// Link the XInput library
+#pragma comment(lib, "XInput.lib")
+
+//-----------------------------------------------------------------------------
+// Purpose:
+// Set a function pointer to the xinput get state call. By default, set it to
+// XInputGetState() in whichever xinput we are linked to (xinput9_1_0.dll). If
+// the d3dx.ini is using the guide button we will try to switch to either
+// xinput 1.3 or 1.4 to get access to the undocumented XInputGetStateEx() call.
+// We can't rely on these existing on Win7 though, so if we fail to load them
+// don't treat it as fatal and continue using the original one.
+//-----------------------------------------------------------------------------
+static HMODULE xinput_lib;
+typedef DWORD(WINAPI* tXInputGetState)(DWORD dwUserIndex, XINPUT_STATE* pState);
+static tXInputGetState _XInputGetState = XInputGetState;
+static void SwitchToXinpuGetStateEx()
+{
+    tXInputGetState XInputGetStateEx;
+
+    if (xinput_lib)
+        return;
+
+    // 3DMigoto is linked against xinput9_1_0.dll, but that version does
+    // not export XInputGetStateEx to get the guide button. Try loading
+    // xinput 1.3 and 1.4, which both support this functionality.
+    xinput_lib = LoadLibrary(L"xinput1_3.dll");
+    if (xinput_lib) {
+        DriverLog("Loaded xinput1_3.dll for guide button support\n");
+    }
+    else {
+        xinput_lib = LoadLibrary(L"xinput1_4.dll");
+        if (xinput_lib) {
+            DriverLog("Loaded xinput1_4.dll for guide button support\n");
+        }
+        else {
+            DriverLog("ERROR: Unable to load xinput 1.3 or 1.4: Guide button will not be available\n");
+            return;
+        }
+    }
+
+    // Unnamed and undocumented exports FTW
+    LPCSTR XInputGetStateExOrdinal = (LPCSTR)100;
+    XInputGetStateEx = (tXInputGetState)GetProcAddress(xinput_lib, XInputGetStateExOrdinal);
+    if (!XInputGetStateEx) {
+        DriverLog("ERROR: Unable to get XInputGetStateEx: Guide button will not be available\n");
+        return;
+    }
+
+    _XInputGetState = XInputGetStateEx;
+}
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Gamepad backend for the XInput user slots
+//-----------------------------------------------------------------------------
+class XInputBackend : public IGamepadBackend
+{
+public:
+    bool GetState(uint32_t slot, GamepadState& state) override
+    {
+        XINPUT_STATE xstate;
+        ZeroMemory(&xstate, sizeof(XINPUT_STATE));
+        if (_XInputGetState(slot, &xstate) != ERROR_SUCCESS)
+            return false;
+
+        state.buttons = xstate.Gamepad.wButtons;
+        state.left_trigger = xstate.Gamepad.bLeftTrigger;
+        state.right_trigger = xstate.Gamepad.bRightTrigger;
+        state.thumb_lx = xstate.Gamepad.sThumbLX;
+        state.thumb_ly = xstate.Gamepad.sThumbLY;
+        state.thumb_rx = xstate.Gamepad.sThumbRX;
+        state.thumb_ry = xstate.Gamepad.sThumbRY;
+        return true;
+    }
+};
+
+
+//-----------------------------------------------------------------------------
+// Purpose: XInput backend, on XInputGetStateEx if it could be loaded
+//-----------------------------------------------------------------------------
+std::unique_ptr< IGamepadBackend > CreateXInputBackend()
+{
+    SwitchToXinpuGetStateEx();
+    return std::make_unique< XInputBackend >();
+}
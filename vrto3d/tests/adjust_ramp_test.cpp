@@ -0,0 +1,109 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+
+#include "adjust_ramp.h"
+#include "test_common.h"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    const float k_first_step = 0.016667f;
+
+    // Total change from holding a direction for held, stepping every tick
+    float Hold( AdjustRamp &ramp, AdjustRamp::Clock::time_point start, std::chrono::milliseconds tick, std::chrono::milliseconds held, float rate, float accel )
+    {
+        float total = 0.0f;
+        for ( auto t = 0ms; t <= held; t += tick )
+            total += ramp.Step( 1, start + t, rate, accel );
+        return total;
+    }
+
+    void TestTap()
+    {
+        AdjustRamp ramp;
+        AdjustRamp::Clock::time_point t0;
+        CHECK( ramp.Step( 0, t0, 1.0f, 0.0f ) == 0.0f );
+        // A fresh press moves by one 60Hz frame worth
+        CHECK_NEAR( ramp.Step( 1, t0, 2.0f, 0.0f ), 2.0f * k_first_step, 1e-6 );
+        ramp.Reset();
+        CHECK_NEAR( ramp.Step( -1, t0, 2.0f, 0.0f ), -2.0f * k_first_step, 1e-6 );
+        // Letting go and pressing again starts a new ramp
+        CHECK( ramp.Step( 0, t0 + 1ms, 2.0f, 0.0f ) == 0.0f );
+        CHECK_NEAR( ramp.Step( -1, t0 + 2ms, 2.0f, 0.0f ), -2.0f * k_first_step, 1e-6 );
+    }
+
+    void TestRateIndependent()
+    {
+        AdjustRamp::Clock::time_point t0;
+
+        // Constant rate: the total only depends on how long the key was held
+        AdjustRamp fine, coarse;
+        float fine_total = Hold( fine, t0, 1ms, 2000ms, 0.5f, 0.0f );
+        float coarse_total = Hold( coarse, t0, 16ms, 2000ms - 2000ms % 16, 0.5f, 0.0f ) + coarse.Step( 1, t0 + 2000ms, 0.5f, 0.0f );
+        CHECK_NEAR( fine_total, 0.5f * ( 2.0f + k_first_step ), 1e-4 );
+        CHECK_NEAR( coarse_total, fine_total, 1e-4 );
+
+        // Accelerating: integral of rate * ( 1 + accel * t )
+        AdjustRamp fast, slow;
+        float t = 2.0f + k_first_step;
+        float expected = 0.5f * ( t + 0.5f * 1.0f * t * t );
+        CHECK_NEAR( Hold( fast, t0, 1ms, 2000ms, 0.5f, 1.0f ), expected, 1e-3 );
+        CHECK_NEAR( Hold( slow, t0, 50ms, 2000ms, 0.5f, 1.0f ), expected, 1e-3 );
+    }
+
+    void TestSpeedupCap()
+    {
+        AdjustRamp ramp;
+        AdjustRamp::Clock::time_point t0;
+        Hold( ramp, t0, 10ms, 20000ms, 1.0f, 1.0f );
+        // Long past the cap the rate stays at k_max_speedup times the base
+        CHECK_NEAR( ramp.Step( 1, t0 + 20010ms, 1.0f, 1.0f ), AdjustRamp::k_max_speedup * 0.01f, 1e-4 );
+        CHECK_NEAR( ramp.Step( 1, t0 + 30000ms, 1.0f, 1.0f ), AdjustRamp::k_max_speedup * 0.1f, 1e-3 );
+    }
+
+    void TestStall()
+    {
+        AdjustRamp ramp;
+        AdjustRamp::Clock::time_point t0;
+        ramp.Step( 1, t0, 1.0f, 0.0f );
+        // A one second stall only integrates the last 100ms
+        CHECK_NEAR( ramp.Step( 1, t0 + 1000ms, 1.0f, 0.0f ), 0.1f, 1e-5 );
+    }
+
+    void TestReverse()
+    {
+        AdjustRamp ramp;
+        AdjustRamp::Clock::time_point t0;
+        Hold( ramp, t0, 10ms, 3000ms, 1.0f, 1.0f );
+        // Switching direction restarts from the base rate
+        CHECK_NEAR( ramp.Step( -1, t0 + 3010ms, 1.0f, 1.0f ), -( k_first_step + 0.5f * k_first_step * k_first_step ), 1e-5 );
+    }
+}
+
+
+int main()
+{
+    TestTap();
+    TestRateIndependent();
+    TestSpeedupCap();
+    TestStall();
+    TestReverse();
+    return TestResult( "adjust_ramp_test" );
+}
@@ -0,0 +1,164 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstdint>
+
+#include "axis_mapping.h"
+#include "test_common.h"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    InputSample Stick( int16_t rx, bool connected = true )
+    {
+        InputSample sample = {};
+        sample.connected = connected;
+        sample.pad.thumb_rx = rx;
+        return sample;
+    }
+
+    // Feed the same input every tick for held, applying reported values the
+    // way the driver does; returns the final value and counts the reports
+    float Drive( AxisMapper &mapper, const AxisMapping &mapping, const InputSample &input, AxisMapper::Clock::time_point start,
+        std::chrono::milliseconds tick, std::chrono::milliseconds held, float current, int *reports = nullptr )
+    {
+        for ( auto t = 0ms; t <= held; t += tick )
+        {
+            float value;
+            if ( mapper.Update( mapping, input, start + t, current, value ) )
+            {
+                current = value;
+                if ( reports )
+                    ( *reports )++;
+            }
+        }
+        return current;
+    }
+
+    void TestReadAxis()
+    {
+        GamepadState pad = {};
+        pad.left_trigger = 51;
+        pad.right_trigger = 255;
+        pad.thumb_lx = -32768;
+        pad.thumb_ly = 32767;
+        pad.thumb_ry = -16384;
+        CHECK_NEAR( AxisMapper::ReadAxis( AXIS_TRIGGERS, pad ), 0.8, 1e-6 );
+        CHECK_NEAR( AxisMapper::ReadAxis( AXIS_LEFT_TRIGGER, pad ), 0.2, 1e-6 );
+        CHECK_NEAR( AxisMapper::ReadAxis( AXIS_RIGHT_TRIGGER, pad ), 1.0, 1e-6 );
+        // The extra negative step of a stick is clamped
+        CHECK( AxisMapper::ReadAxis( AXIS_LEFT_STICK_X, pad ) == -1.0f );
+        CHECK( AxisMapper::ReadAxis( AXIS_LEFT_STICK_Y, pad ) == 1.0f );
+        CHECK( AxisMapper::ReadAxis( AXIS_RIGHT_STICK_X, pad ) == 0.0f );
+        CHECK_NEAR( AxisMapper::ReadAxis( AXIS_RIGHT_STICK_Y, pad ), -0.5, 1e-4 );
+        CHECK( AxisMapper::ReadAxis( AXIS_NONE, pad ) == 0.0f );
+        CHECK( AxisMapping{}.axis == AXIS_NONE );
+        CHECK( AxisMappings.at( "right_stick_x" ) == AXIS_RIGHT_STICK_X );
+    }
+
+    void TestDeadzone()
+    {
+        AxisMapper mapper;
+        AxisMapping mapping = { AXIS_RIGHT_STICK_X, 0.2f, 1.0f, 1.0f, 0.0f };
+        AxisMapper::Clock::time_point t0;
+        // Inside the deadzone or unplugged nothing moves
+        CHECK( Drive( mapper, mapping, Stick( 6000 ), t0, 10ms, 1000ms, 0.5f ) == 0.5f );
+        CHECK( Drive( mapper, mapping, Stick( 32767, false ), t0, 10ms, 1000ms, 0.5f ) == 0.5f );
+        // Just past it the travel is rescaled from zero, not jumping to 0.2
+        float value = Drive( mapper, mapping, Stick( 9830 ), t0, 10ms, 1000ms, 0.0f );
+        CHECK( value > 0.0f && value < 0.2f );
+
+        // The same rule decides whether the hotkey thread may idle
+        CHECK( !AxisMapper::IsDeflected( mapping, Stick( 6000 ) ) );
+        CHECK( !AxisMapper::IsDeflected( mapping, Stick( 32767, false ) ) );
+        CHECK( AxisMapper::IsDeflected( mapping, Stick( -9830 ) ) );
+        mapping.axis = AXIS_NONE;
+        CHECK( !AxisMapper::IsDeflected( mapping, Stick( 32767 ) ) );
+    }
+
+    void TestRateAndCurve()
+    {
+        AxisMapper::Clock::time_point t0;
+
+        // Full deflection moves rate units per second, the first tick only arms it
+        AxisMapper full;
+        AxisMapping linear = { AXIS_RIGHT_STICK_X, 0.0f, 1.0f, 2.0f, 0.0f };
+        CHECK_NEAR( Drive( full, linear, Stick( 32767 ), t0, 10ms, 1000ms, 1.0f ), 3.0, 1e-4 );
+
+        AxisMapper left;
+        CHECK_NEAR( Drive( left, linear, Stick( -32768 ), t0, 10ms, 500ms, 1.0f ), 0.0, 1e-4 );
+
+        // Half deflection with a square curve moves at a quarter of the rate
+        AxisMapper half;
+        AxisMapping squared = { AXIS_RIGHT_STICK_X, 0.0f, 2.0f, 2.0f, 0.0f };
+        CHECK_NEAR( Drive( half, squared, Stick( 16384 ), t0, 10ms, 1000ms, 0.0f ), 0.5, 1e-3 );
+
+        // A stall only integrates 100ms
+        AxisMapper stalled;
+        float value = 0.0f;
+        CHECK( !stalled.Update( linear, Stick( 32767 ), t0, 0.0f, value ) );
+        CHECK( stalled.Update( linear, Stick( 32767 ), t0 + 5s, 0.0f, value ) );
+        CHECK_NEAR( value, 0.2, 1e-5 );
+    }
+
+    void TestQuantized()
+    {
+        AxisMapper::Clock::time_point t0;
+        AxisMapper mapper;
+        AxisMapping mapping = { AXIS_RIGHT_STICK_X, 0.0f, 1.0f, 0.1f, 0.01f };
+
+        // 0.1 per second in 0.01 steps: ten reports over a second of 1ms ticks, not a thousand
+        int reports = 0;
+        float value = Drive( mapper, mapping, Stick( 32767 ), t0, 1ms, 1000ms, 0.0f, &reports );
+        CHECK_NEAR( value, 0.1, 1e-5 );
+        CHECK( reports == 10 );
+    }
+
+    void TestFollowsExternalChanges()
+    {
+        AxisMapper::Clock::time_point t0;
+        AxisMapper mapper;
+        AxisMapping mapping = { AXIS_RIGHT_STICK_X, 0.0f, 1.0f, 1.0f, 0.0f };
+        float value = Drive( mapper, mapping, Stick( 32767 ), t0, 10ms, 500ms, 0.0f );
+        CHECK_NEAR( value, 0.5, 1e-4 );
+
+        // A hotkey moved the value meanwhile: the mapper picks it up instead of overwriting it
+        float out = 0.0f;
+        CHECK( !mapper.Update( mapping, Stick( 32767 ), t0 + 520ms, 5.0f, out ) );
+        CHECK( mapper.Update( mapping, Stick( 32767 ), t0 + 530ms, 5.0f, out ) );
+        CHECK_NEAR( out, 5.01, 1e-5 );
+
+        // After letting go the next deflection starts a fresh, armed-only tick
+        CHECK( !mapper.Update( mapping, Stick( 0 ), t0 + 540ms, out, out ) );
+        float before = out;
+        CHECK( !mapper.Update( mapping, Stick( 32767 ), t0 + 2s, before, out ) );
+        CHECK( out == before );
+    }
+}
+
+
+int main()
+{
+    TestReadAxis();
+    TestDeadzone();
+    TestRateAndCurve();
+    TestQuantized();
+    TestFollowsExternalChanges();
+    return TestResult( "axis_mapping_test" );
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstdint>
+
+#include "binding_state.h"
+#include "test_common.h"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // Injected clock: the tests step time by hand instead of sleeping
+    struct FakeClock
+    {
+        BindingState::Clock::time_point now;
+
+        BindingState::Clock::time_point At( std::chrono::milliseconds ms ) const
+        {
+            return now + ms;
+        }
+    };
+
+    void TestPressRelease()
+    {
+        FakeClock clock;
+        BindingState bind;
+        CHECK( bind.Update( false, clock.At( 0ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 1ms ) ) == BIND_PRESS );
+        CHECK( bind.IsPressed() );
+        // No auto-repeat unless an interval is given
+        CHECK( bind.Update( true, clock.At( 10s ) ) == 0 );
+        CHECK( bind.Update( false, clock.At( 11s ) ) == BIND_RELEASE );
+        CHECK( !bind.IsPressed() );
+        CHECK( bind.Update( false, clock.At( 12s ) ) == 0 );
+    }
+
+    void TestDebounce()
+    {
+        FakeClock clock;
+        BindingState bind( 100ms );
+        CHECK( bind.Update( true, clock.At( 0ms ) ) == BIND_PRESS );
+        CHECK( bind.Update( false, clock.At( 10ms ) ) == BIND_RELEASE );
+
+        // A bounce inside the window is held back while the key stays down...
+        CHECK( bind.Update( true, clock.At( 50ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 99ms ) ) == 0 );
+        // ...and accepted once the window has passed
+        CHECK( bind.Update( true, clock.At( 100ms ) ) == BIND_PRESS );
+        CHECK( bind.Update( false, clock.At( 110ms ) ) == BIND_RELEASE );
+
+        // Released again before the window ends, it never becomes a press
+        CHECK( bind.Update( true, clock.At( 150ms ) ) == 0 );
+        CHECK( bind.Update( false, clock.At( 160ms ) ) == 0 );
+        CHECK( bind.Update( false, clock.At( 300ms ) ) == 0 );
+
+        // Reset forgets the previous press
+        bind.Reset();
+        CHECK( bind.Update( true, clock.At( 301ms ) ) == BIND_PRESS );
+        bind.Update( false, clock.At( 302ms ) );
+        bind.Reset();
+        CHECK( bind.Update( true, clock.At( 303ms ) ) == BIND_PRESS );
+    }
+
+    void TestRepeat()
+    {
+        FakeClock clock;
+        BindingState bind( 0ms, 300ms, 25ms );
+        CHECK( bind.Update( true, clock.At( 0ms ) ) == BIND_PRESS );
+        CHECK( bind.Update( true, clock.At( 299ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 300ms ) ) == BIND_REPEAT );
+        CHECK( bind.Update( true, clock.At( 324ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 325ms ) ) == BIND_REPEAT );
+
+        // A stalled caller gets one repeat, not a burst, and the schedule restarts
+        CHECK( bind.Update( true, clock.At( 500ms ) ) == BIND_REPEAT );
+        CHECK( bind.Update( true, clock.At( 501ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 524ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 525ms ) ) == BIND_REPEAT );
+
+        // Releasing and pressing again starts over from the delay
+        CHECK( bind.Update( false, clock.At( 530ms ) ) == BIND_RELEASE );
+        CHECK( bind.Update( true, clock.At( 540ms ) ) == BIND_PRESS );
+        CHECK( bind.Update( true, clock.At( 600ms ) ) == 0 );
+        CHECK( bind.Update( true, clock.At( 840ms ) ) == BIND_REPEAT );
+    }
+
+    int CountRepeats( std::chrono::milliseconds tick, std::chrono::milliseconds held )
+    {
+        FakeClock clock;
+        BindingState bind( 0ms, 300ms, 25ms );
+        int repeats = 0;
+        for ( auto t = 0ms; t <= held; t += tick )
+        {
+            if ( bind.Update( true, clock.At( t ) ) & BIND_REPEAT )
+                repeats++;
+        }
+        return repeats;
+    }
+
+    void TestRateIndependent()
+    {
+        // Same number of repeats over the same hold, however often it is polled
+        CHECK( CountRepeats( 1ms, 1000ms ) == 29 );
+        CHECK( CountRepeats( 5ms, 1000ms ) == 29 );
+        CHECK( CountRepeats( 20ms, 1000ms ) == 29 );
+    }
+}
+
+
+int main()
+{
+    TestPressRelease();
+    TestDebounce();
+    TestRepeat();
+    TestRateIndependent();
+    return TestResult( "binding_state_test" );
+}
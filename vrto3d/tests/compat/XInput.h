@@ -0,0 +1,36 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Stand-in for <XInput.h> on non-Windows hosts, only the button constants
+// key_mappings.h refers to; values match XInput.h
+
+#define XINPUT_GAMEPAD_DPAD_UP               0x0001
+#define XINPUT_GAMEPAD_DPAD_DOWN             0x0002
+#define XINPUT_GAMEPAD_DPAD_LEFT             0x0004
+#define XINPUT_GAMEPAD_DPAD_RIGHT            0x0008
+#define XINPUT_GAMEPAD_START                 0x0010
+#define XINPUT_GAMEPAD_BACK                  0x0020
+#define XINPUT_GAMEPAD_LEFT_THUMB            0x0040
+#define XINPUT_GAMEPAD_RIGHT_THUMB           0x0080
+#define XINPUT_GAMEPAD_LEFT_SHOULDER         0x0100
+#define XINPUT_GAMEPAD_RIGHT_SHOULDER        0x0200
+#define XINPUT_GAMEPAD_A                     0x1000
+#define XINPUT_GAMEPAD_B                     0x2000
+#define XINPUT_GAMEPAD_X                     0x4000
+#define XINPUT_GAMEPAD_Y                     0x8000
+#define XINPUT_GAMEPAD_TRIGGER_THRESHOLD     30
@@ -0,0 +1,95 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Stand-in for <windows.h> on non-Windows hosts, only the virtual key codes
+// key_mappings.h refers to; values match WinUser.h
+
+#define VK_LBUTTON   0x01
+#define VK_RBUTTON   0x02
+#define VK_MBUTTON   0x04
+#define VK_XBUTTON1  0x05
+#define VK_XBUTTON2  0x06
+#define VK_BACK      0x08
+#define VK_TAB       0x09
+#define VK_SHIFT     0x10
+#define VK_CONTROL   0x11
+#define VK_MENU      0x12
+#define VK_PAUSE     0x13
+#define VK_CAPITAL   0x14
+#define VK_ESCAPE    0x1B
+#define VK_SPACE     0x20
+#define VK_PRIOR     0x21
+#define VK_NEXT      0x22
+#define VK_END       0x23
+#define VK_HOME      0x24
+#define VK_LEFT      0x25
+#define VK_UP        0x26
+#define VK_RIGHT     0x27
+#define VK_DOWN      0x28
+#define VK_SNAPSHOT  0x2C
+#define VK_INSERT    0x2D
+#define VK_DELETE    0x2E
+#define VK_NUMPAD0   0x60
+#define VK_NUMPAD1   0x61
+#define VK_NUMPAD2   0x62
+#define VK_NUMPAD3   0x63
+#define VK_NUMPAD4   0x64
+#define VK_NUMPAD5   0x65
+#define VK_NUMPAD6   0x66
+#define VK_NUMPAD7   0x67
+#define VK_NUMPAD8   0x68
+#define VK_NUMPAD9   0x69
+#define VK_MULTIPLY  0x6A
+#define VK_ADD       0x6B
+#define VK_SUBTRACT  0x6D
+#define VK_DECIMAL   0x6E
+#define VK_DIVIDE    0x6F
+#define VK_F1        0x70
+#define VK_F2        0x71
+#define VK_F3        0x72
+#define VK_F4        0x73
+#define VK_F5        0x74
+#define VK_F6        0x75
+#define VK_F7        0x76
+#define VK_F8        0x77
+#define VK_F9        0x78
+#define VK_F10       0x79
+#define VK_F11       0x7A
+#define VK_F12       0x7B
+#define VK_F13       0x7C
+#define VK_F14       0x7D
+#define VK_F15       0x7E
+#define VK_F16       0x7F
+#define VK_F17       0x80
+#define VK_F18       0x81
+#define VK_F19       0x82
+#define VK_F20       0x83
+#define VK_F21       0x84
+#define VK_F22       0x85
+#define VK_F23       0x86
+#define VK_F24       0x87
+#define VK_LSHIFT    0xA0
+#define VK_RSHIFT    0xA1
+#define VK_LCONTROL  0xA2
+#define VK_RCONTROL  0xA3
+#define VK_LMENU     0xA4
+#define VK_RMENU     0xA5
+#define VK_OEM_PLUS  0xBB
+#define VK_OEM_MINUS 0xBD
+#define VK_OEM_4     0xDB
+#define VK_OEM_6     0xDD
@@ -0,0 +1,245 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "axis_mapping.h"
+#include "config_fields.h"
+#include "json_manager.h"
+#include "key_mappings.h"
+#include "pose_prediction.h"
+#include "test_common.h"
+
+
+namespace
+{
+    // Compile a JSON text the way JsonManager does, size and write time are only used by the sidecar check
+    CompiledProfile Compile( const std::string &text )
+    {
+        return CompileProfile( nlohmann::json::parse( text ), text.size(), 1, "test.json" );
+    }
+
+    // Display settings and profile from one file, as for default_config.json
+    StereoDisplayDriverConfiguration BindAll( const CompiledProfile &profile, const StereoDisplayDriverConfiguration *defaults = nullptr )
+    {
+        StereoDisplayDriverConfiguration config{};
+        BindParams( profile, config, "test.json" );
+        BindProfile( profile, config, "test.json", defaults );
+        return config;
+    }
+
+    void TestBuiltInDefaults()
+    {
+        // A missing file resets every field to its built-in default
+        StereoDisplayDriverConfiguration config = BindAll( CompiledProfile() );
+        CHECK( config.window_width == 1920 && config.window_height == 1080 );
+        CHECK_NEAR( config.depth, 0.5, 1e-7 );
+        CHECK_NEAR( config.convergence, 0.02, 1e-7 );
+        CHECK( config.debug_enable && !config.tab_enable );
+        CHECK( config.pose_prediction_str == "none" && config.pose_prediction == PREDICT_NONE );
+        CHECK( config.depth_axis == AXIS_NONE );
+        CHECK( config.pose_reset_str == "VK_NUMPAD7" );
+        CHECK( config.ctrl_type_str == "toggle" && config.ctrl_type == TOGGLE );
+        CHECK( config.num_user_settings == 0 && config.user_depth.empty() );
+
+        // default_config.json written from the table binds to the same values
+        StereoDisplayDriverConfiguration written = BindAll( Compile( DefaultsToJson().dump() ) );
+        CHECK( ProfileToJson( written ) == ProfileToJson( config ) );
+        CHECK( written.window_width == config.window_width && written.fov == config.fov && written.axis_step == config.axis_step );
+        CHECK( written.pose_prediction == config.pose_prediction && written.notify_tone == config.notify_tone );
+
+        // Every display and profile setting is in the defaults, and only those
+        nlohmann::ordered_json defaults = DefaultsToJson();
+        CHECK( defaults.contains( "window_width" ) && defaults.contains( "display_latency" ) && defaults.contains( "ctrl_sensitivity" ) );
+        CHECK( !defaults.contains( "user_depth" ) && !defaults.contains( k_user_settings_key ) );
+    }
+
+    void TestRoundTrip()
+    {
+        StereoDisplayDriverConfiguration config = BindAll( CompiledProfile() );
+        config.hmd_height = 1.5f;
+        config.depth = 0.25f;
+        config.convergence = 0.125f;
+        config.pitch_enable = true;
+        config.pose_reset_str = "VK_F1+XINPUT_GAMEPAD_A";
+        config.ctrl_type_str = "switch";
+        config.pitch_radius = 0.375f;
+        config.num_user_settings = 2;
+        config.user_load_str = { "VK_NUMPAD1", "XINPUT_GAMEPAD_DPAD_UP" };
+        config.user_store_str = { "VK_CONTROL+VK_NUMPAD1", "" };
+        config.user_type_str = { "toggle", "switch" };
+        config.user_key_type = { TOGGLE, SWITCH };
+        config.user_depth = { 0.75f, 2.0f };
+        config.user_convergence = { 0.0625f, 0.5f };
+
+        // Saved, compiled and bound again gives back the same profile
+        nlohmann::ordered_json saved = ProfileToJson( config );
+        CHECK( saved[ k_user_settings_key ].size() == 2 );
+        CHECK( !saved.contains( "window_width" ) );
+
+        StereoDisplayDriverConfiguration loaded = BindAll( Compile( saved.dump() ) );
+        CHECK( ProfileToJson( loaded ) == saved );
+        CHECK( loaded.depth == 0.25f && loaded.pitch_radius == 0.375f && loaded.pitch_enable );
+        CHECK( loaded.pose_reset_str == "VK_F1+XINPUT_GAMEPAD_A" );
+        CHECK( loaded.ctrl_type == SWITCH );
+        CHECK( loaded.num_user_settings == 2 );
+        CHECK( loaded.user_key_type.size() == 2 && loaded.user_key_type[ 0 ] == TOGGLE && loaded.user_key_type[ 1 ] == SWITCH );
+        CHECK( loaded.user_depth.size() == 2 && loaded.user_depth[ 1 ] == 2.0f );
+        CHECK( loaded.user_store_str.size() == 2 && loaded.user_store_str[ 1 ].empty() );
+        // The per-user runtime state is sized along with the settings
+        CHECK( loaded.prev_depth.size() == 2 && loaded.was_held.size() == 2 );
+    }
+
+    void TestInvalidValues()
+    {
+        StereoDisplayDriverConfiguration config = BindAll( Compile( R"({
+            "window_width": 100000,
+            "window_height": "big",
+            "render_width": 0,
+            "fov": 500,
+            "depth": -1,
+            "pose_prediction": "bogus",
+            "ctrl_toggle_type": 2,
+            "pitch_enable": "yes",
+            "not_a_setting": 1,
+            "user_depth": 3.0,
+            "user_settings": [ { "user_depth": [ 1 ], "user_key_type": "toggle", "depth": 9.0 } ]
+        })" ) );
+
+        // Out of range numbers are clamped, anything of the wrong type is defaulted
+        CHECK( config.window_width == 16384 );
+        CHECK( config.window_height == 1080 );
+        CHECK( config.render_width == 1 );
+        CHECK( config.fov == 179.0f );
+        CHECK( config.depth == 0.0f );
+        CHECK( config.pitch_enable == false );
+        CHECK( config.ctrl_type_str == "toggle" && config.ctrl_type == TOGGLE );
+
+        // Unknown names keep the text, for saving back, with the fallback value
+        CHECK( config.pose_prediction_str == "bogus" && config.pose_prediction == PREDICT_NONE );
+
+        // User fields only count inside user_settings and profile fields only outside
+        CHECK( config.num_user_settings == 1 );
+        CHECK( config.user_depth[ 0 ] == 0.5f );
+        CHECK( config.user_key_type[ 0 ] == TOGGLE );
+
+        // Huge numbers are clamped before the int conversion, not overflowed
+        StereoDisplayDriverConfiguration wide = BindAll( Compile( R"({ "window_width": 1e300 })" ) );
+        CHECK( wide.window_width == 16384 );
+    }
+
+    void TestProfileDefaults()
+    {
+        // default_config.json with its own profile settings and one user setting
+        StereoDisplayDriverConfiguration defaults = BindAll( Compile( R"({
+            "depth": 0.3,
+            "pose_reset_key": "VK_F5",
+            "user_settings": [ { "user_load_key": "VK_NUMPAD1", "user_depth": 1.25 } ]
+        })" ) );
+        CHECK( defaults.num_user_settings == 1 );
+
+        // A partial game profile takes the rest from the defaults, user settings included
+        StereoDisplayDriverConfiguration game = defaults;
+        BindProfile( Compile( R"({ "convergence": 0.125 })" ), game, "game.json", &defaults );
+        CHECK( game.convergence == 0.125f );
+        CHECK( game.depth == 0.3f );
+        CHECK( game.pose_reset_str == "VK_F5" );
+        CHECK( game.num_user_settings == 1 && game.user_depth[ 0 ] == 1.25f && game.user_load_str[ 0 ] == "VK_NUMPAD1" );
+
+        // An explicit empty array means no user settings
+        BindProfile( Compile( R"({ "user_settings": [] })" ), game, "game.json", &defaults );
+        CHECK( game.num_user_settings == 0 && game.user_depth.empty() );
+
+        // Entries past the defaults' user settings fall back to the built-in defaults
+        BindProfile( Compile( R"({ "user_settings": [ { "user_convergence": 0.25 }, {} ] })" ), game, "game.json", &defaults );
+        CHECK( game.num_user_settings == 2 );
+        CHECK( game.user_convergence[ 0 ] == 0.25f && game.user_depth[ 0 ] == 1.25f );
+        CHECK( game.user_depth[ 1 ] == 0.5f && game.user_load_str[ 1 ].empty() && game.user_key_type[ 1 ] == SWITCH );
+
+        // Without defaults, as for a reset, missing fields get the built-in defaults
+        BindProfile( Compile( R"({ "convergence": 0.125 })" ), game, "game.json", nullptr );
+        CHECK( game.depth == 0.5f && game.pose_reset_str == "VK_NUMPAD7" && game.num_user_settings == 0 );
+    }
+
+    void TestSidecarValidation()
+    {
+        const std::string text = R"({ "depth": 0.25, "pose_reset_key": "VK_F5", "user_settings": [ { "user_depth": 1.0 } ] })";
+        CompiledProfile profile = Compile( text );
+        CHECK( ValidateProfile( profile.data(), profile.size(), text.size(), 1 ) );
+
+        // Stale against the JSON it was compiled from
+        CHECK( !ValidateProfile( profile.data(), profile.size(), text.size() + 1, 1 ) );
+        CHECK( !ValidateProfile( profile.data(), profile.size(), text.size(), 2 ) );
+
+        // Truncated, padded or not a sidecar at all
+        CHECK( !ValidateProfile( profile.data(), 0, text.size(), 1 ) );
+        CHECK( !ValidateProfile( profile.data(), profile.size() - 1, text.size(), 1 ) );
+        CompiledProfile padded = profile;
+        padded.push_back( 0 );
+        CHECK( !ValidateProfile( padded.data(), padded.size(), text.size(), 1 ) );
+        CompiledProfile foreign = profile;
+        foreign[ 0 ] ^= 0xFF;
+        CHECK( !ValidateProfile( foreign.data(), foreign.size(), text.size(), 1 ) );
+
+        // A damaged value entry, the last 24 bytes when there are no strings
+        const std::string plain = R"({ "depth": 0.25 })";
+        CompiledProfile damaged = Compile( plain );
+        CHECK( ValidateProfile( damaged.data(), damaged.size(), plain.size(), 1 ) );
+        std::fill( damaged.end() - 24, damaged.end(), 0xFF );
+        CHECK( !ValidateProfile( damaged.data(), damaged.size(), plain.size(), 1 ) );
+
+        // A string offset so large that offset + length wraps around into the table
+        const std::string key = R"({ "pose_reset_key": "VK_F5" })";
+        CompiledProfile wrapped = Compile( key );
+        CHECK( ValidateProfile( wrapped.data(), wrapped.size(), key.size(), 1 ) );
+        bool found = false;
+        for ( size_t at = 0; at + 16 <= wrapped.size(); at += 8 )
+        {
+            // Value entries are { uint32 kind, uint32 length, uint64 offset, double number }
+            uint32_t kind, length;
+            uint64_t offset;
+            std::memcpy( &kind, &wrapped[ at ], sizeof( kind ) );
+            std::memcpy( &length, &wrapped[ at + 4 ], sizeof( length ) );
+            std::memcpy( &offset, &wrapped[ at + 8 ], sizeof( offset ) );
+            if ( kind == 3 && length == 5 && offset == 0 )
+            {
+                offset = std::numeric_limits< uint64_t >::max() - 2;
+                std::memcpy( &wrapped[ at + 8 ], &offset, sizeof( offset ) );
+                found = true;
+                break;
+            }
+        }
+        CHECK( found );
+        CHECK( !ValidateProfile( wrapped.data(), wrapped.size(), key.size(), 1 ) );
+    }
+}
+
+
+int main()
+{
+    TestBuiltInDefaults();
+    TestRoundTrip();
+    TestInvalidValues();
+    TestProfileDefaults();
+    TestSidecarValidation();
+    return TestResult( "config_fields_test" );
+}
@@ -0,0 +1,188 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "gamepad_poller.h"
+#include "test_common.h"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // Pads the test plugs in and out, and how often each slot was queried
+    struct FakePads
+    {
+        std::array< bool, GamepadPoller::k_max_slots > connected = {};
+        std::array< GamepadState, GamepadPoller::k_max_slots > state = {};
+        std::array< int, GamepadPoller::k_max_slots > calls = {};
+    };
+
+    class FakeBackend : public IGamepadBackend
+    {
+    public:
+        explicit FakeBackend( FakePads &pads ) : pads_( pads ) {}
+
+        bool GetState( uint32_t slot, GamepadState &state ) override
+        {
+            pads_.calls[ slot ]++;
+            if ( !pads_.connected[ slot ] )
+                return false;
+            state = pads_.state[ slot ];
+            return true;
+        }
+
+    private:
+        FakePads &pads_;
+    };
+
+    void TestProbeOneEmptySlotPerTick()
+    {
+        FakePads pads;
+        pads.connected[ 2 ] = true;
+        pads.state[ 2 ].buttons = 0x1000;
+        GamepadPoller poller( std::make_unique< FakeBackend >( pads ), 2s );
+        GamepadPoller::Clock::time_point t0;
+        GamepadState merged;
+
+        // Slots are probed round robin, one per tick
+        CHECK( !poller.Poll( t0, merged ) );
+        CHECK( !poller.Poll( t0 + 1ms, merged ) );
+        CHECK( pads.calls[ 0 ] == 1 && pads.calls[ 1 ] == 1 && pads.calls[ 2 ] == 0 );
+        CHECK( poller.Poll( t0 + 2ms, merged ) );
+        CHECK( poller.IsConnected( 2 ) );
+        CHECK( merged.buttons == 0x1000 );
+        CHECK( poller.Poll( t0 + 3ms, merged ) );
+        CHECK( pads.calls[ 3 ] == 1 );
+
+        // Connected slots are read every tick, empty ones wait out the back-off
+        for ( int i = 0; i < 100; i++ )
+            CHECK( poller.Poll( t0 + 4ms + i * 10ms, merged ) );
+        CHECK( pads.calls[ 2 ] == 102 );
+        CHECK( pads.calls[ 0 ] == 1 && pads.calls[ 1 ] == 1 && pads.calls[ 3 ] == 1 );
+
+        poller.Poll( t0 + 2s, merged );
+        CHECK( pads.calls[ 0 ] == 2 && pads.calls[ 1 ] == 1 );
+        poller.Poll( t0 + 2s + 1ms, merged );
+        CHECK( pads.calls[ 1 ] == 2 );
+    }
+
+    void TestDisconnect()
+    {
+        FakePads pads;
+        pads.connected[ 0 ] = true;
+        GamepadPoller poller( std::make_unique< FakeBackend >( pads ), 2s );
+        GamepadPoller::Clock::time_point t0;
+        GamepadState merged;
+
+        CHECK( poller.Poll( t0, merged ) );
+        pads.connected[ 0 ] = false;
+        CHECK( !poller.Poll( t0 + 1ms, merged ) );
+        CHECK( !poller.IsConnected( 0 ) );
+        CHECK( merged.buttons == 0 );
+
+        // Plugged back in, it is picked up on the first probe after the back-off
+        pads.connected[ 0 ] = true;
+        for ( int i = 0; i < 3; i++ )
+            poller.Poll( t0 + 2ms + i * 1ms, merged );
+        CHECK( pads.calls[ 0 ] == 2 );
+        CHECK( poller.Poll( t0 + 1ms + 2s, merged ) );
+        CHECK( poller.IsConnected( 0 ) );
+    }
+
+    void TestBackOffAndReconnect()
+    {
+        FakePads pads;
+        pads.connected[ 0 ] = true;
+        pads.connected[ 1 ] = true;
+        GamepadPoller poller( std::make_unique< FakeBackend >( pads ), 2s );
+        GamepadPoller::Clock::time_point t0;
+        GamepadState merged;
+
+        poller.Poll( t0, merged );
+        poller.Poll( t0 + 8ms, merged );
+        CHECK( poller.IsConnected( 0 ) && poller.IsConnected( 1 ) );
+
+        // Pad 0 drops out for ten seconds of 8ms ticks: one probe per back-off,
+        // while pad 1 keeps being read every tick
+        pads.connected[ 0 ] = false;
+        pads.calls = {};
+        auto t = t0 + 16ms;
+        for ( int i = 0; i < 1250; i++, t += 8ms )
+            CHECK( poller.Poll( t, merged ) );
+        CHECK( !poller.IsConnected( 0 ) );
+        CHECK( pads.calls[ 1 ] == 1250 );
+        CHECK( pads.calls[ 0 ] == 1 + 4 );
+
+        // Plugged back in, its state is merged from the next probe on
+        pads.connected[ 0 ] = true;
+        pads.state[ 0 ].buttons = 0x0010;
+        int probes = pads.calls[ 0 ];
+        while ( pads.calls[ 0 ] == probes )
+        {
+            poller.Poll( t, merged );
+            t += 8ms;
+        }
+        CHECK( poller.IsConnected( 0 ) );
+        CHECK( merged.buttons == 0x0010 );
+        CHECK( t - ( t0 + 16ms + 1250 * 8ms ) <= 2s + 8ms );
+
+        // Dropping again right away starts a fresh back-off
+        pads.connected[ 0 ] = false;
+        poller.Poll( t, merged );
+        probes = pads.calls[ 0 ];
+        poller.Poll( t + 1s, merged );
+        CHECK( pads.calls[ 0 ] == probes );
+        poller.Poll( t + 2s, merged );
+        CHECK( pads.calls[ 0 ] == probes + 1 );
+    }
+
+    void TestMerge()
+    {
+        FakePads pads;
+        pads.connected[ 0 ] = true;
+        pads.connected[ 1 ] = true;
+        pads.state[ 0 ] = { 0x0001, 200, 10, 1000, 1000, -30000, 0 };
+        pads.state[ 1 ] = { 0x1000, 50, 90, -20000, 0, 100, 100 };
+        GamepadPoller poller( std::make_unique< FakeBackend >( pads ), 2s );
+        GamepadPoller::Clock::time_point t0;
+        GamepadState merged;
+
+        poller.Poll( t0, merged );
+        poller.Poll( t0 + 1ms, merged );
+        CHECK( poller.IsConnected( 0 ) && poller.IsConnected( 1 ) );
+        CHECK( merged.buttons == ( 0x0001 | 0x1000 ) );
+        CHECK( merged.left_trigger == 200 );
+        CHECK( merged.right_trigger == 90 );
+        // Each stick comes whole from the pad deflecting it the most
+        CHECK( merged.thumb_lx == -20000 && merged.thumb_ly == 0 );
+        CHECK( merged.thumb_rx == -30000 && merged.thumb_ry == 0 );
+    }
+}
+
+
+int main()
+{
+    TestProbeOneEmptySlotPerTick();
+    TestDisconnect();
+    TestBackOffAndReconnect();
+    TestMerge();
+    return TestResult( "gamepad_poller_test" );
+}
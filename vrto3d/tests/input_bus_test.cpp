@@ -0,0 +1,158 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "input_bus.h"
+#include "key_mappings.h"
+#include "test_common.h"
+
+
+namespace
+{
+    GamepadState Pad( uint16_t buttons, uint8_t left_trigger = 0, uint8_t right_trigger = 0 )
+    {
+        GamepadState pad = {};
+        pad.buttons = buttons;
+        pad.left_trigger = left_trigger;
+        pad.right_trigger = right_trigger;
+        return pad;
+    }
+
+    void TestPublishLatest()
+    {
+        InputBus bus;
+        InputSample empty = bus.Latest();
+        CHECK( empty.sequence == 0 );
+        CHECK( !empty.connected );
+        CHECK( empty.buttons == 0 );
+
+        InputSample published = bus.Publish( Pad( XINPUT_GAMEPAD_A ), true, 1000 );
+        CHECK( published.sequence == 1 );
+        InputSample latest = bus.Latest();
+        CHECK( latest.sequence == 1 );
+        CHECK( latest.timestamp_us == 1000 );
+        CHECK( latest.connected );
+        CHECK( latest.buttons == XINPUT_GAMEPAD_A );
+    }
+
+    void TestTriggerButtons()
+    {
+        InputBus bus;
+        // The threshold itself is still released, as in XInput
+        CHECK( bus.Publish( Pad( 0, XINPUT_GAMEPAD_TRIGGER_THRESHOLD, 0 ), true, 0 ).buttons == 0 );
+        CHECK( bus.Publish( Pad( 0, XINPUT_GAMEPAD_TRIGGER_THRESHOLD + 1, 0 ), true, 0 ).buttons == XINPUT_GAMEPAD_LEFT_TRIGGER );
+        CHECK( bus.Publish( Pad( XINPUT_GAMEPAD_B, 0, 255 ), true, 0 ).buttons == ( XINPUT_GAMEPAD_B | XINPUT_GAMEPAD_RIGHT_TRIGGER ) );
+
+        // A disconnected pad reports no buttons but keeps the raw state
+        InputSample gone = bus.Publish( Pad( XINPUT_GAMEPAD_B, 255, 255 ), false, 0 );
+        CHECK( gone.buttons == 0 );
+        CHECK( gone.pad.buttons == XINPUT_GAMEPAD_B );
+    }
+
+    void TestCollect()
+    {
+        InputBus bus;
+        uint64_t cursor = 0;
+
+        // A press that was released again before the consumer looked is kept
+        bus.Publish( Pad( 0 ), true, 1 );
+        bus.Publish( Pad( XINPUT_GAMEPAD_X ), true, 2 );
+        bus.Publish( Pad( 0 ), true, 3 );
+        InputSample collected = bus.Collect( cursor );
+        CHECK( cursor == 3 );
+        CHECK( collected.sequence == 3 );
+        CHECK( collected.timestamp_us == 3 );
+        CHECK( collected.buttons == XINPUT_GAMEPAD_X );
+
+        // Nothing new falls back to the latest sample
+        collected = bus.Collect( cursor );
+        CHECK( cursor == 3 );
+        CHECK( collected.sequence == 3 );
+        CHECK( collected.buttons == 0 );
+
+        // Connected if any sample since the cursor was
+        bus.Publish( Pad( 0 ), true, 4 );
+        bus.Publish( Pad( 0 ), false, 5 );
+        CHECK( bus.Collect( cursor ).connected );
+    }
+
+    void TestReadSinceLapped()
+    {
+        InputBus bus;
+        for ( int i = 1; i <= 40; i++ )
+            bus.Publish( Pad( 0 ), true, i );
+
+        // A consumer that fell behind more than the ring only sees the newest samples, in order
+        uint64_t cursor = 0;
+        std::vector< uint64_t > seen;
+        bus.ReadSince( cursor, [ & ]( const InputSample &sample ) { seen.push_back( sample.sequence ); } );
+        CHECK( cursor == 40 );
+        CHECK( seen.size() == 16 );
+        CHECK( !seen.empty() && seen.front() == 25 && seen.back() == 40 );
+        for ( size_t i = 1; i < seen.size(); i++ )
+            CHECK( seen[ i ] == seen[ i - 1 ] + 1 );
+    }
+
+    void TestConcurrentConsumer()
+    {
+        const int samples = 100000;
+        InputBus bus;
+        std::atomic< bool > done( false );
+        int out_of_order = 0;
+        int mismatched = 0;
+        uint64_t last = 0;
+
+        std::thread consumer( [ & ]()
+        {
+            uint64_t cursor = 0;
+            auto check = [ & ]( const InputSample &sample )
+            {
+                if ( sample.sequence <= last )
+                    out_of_order++;
+                if ( sample.timestamp_us != static_cast< int64_t >( sample.sequence ) )
+                    mismatched++;
+                last = sample.sequence;
+            };
+            while ( !done.load( std::memory_order_acquire ) )
+                bus.ReadSince( cursor, check );
+            bus.ReadSince( cursor, check );
+        } );
+
+        for ( int i = 1; i <= samples; i++ )
+            bus.Publish( Pad( static_cast< uint16_t >( i ) ), true, i );
+        done.store( true, std::memory_order_release );
+        consumer.join();
+
+        CHECK( out_of_order == 0 );
+        CHECK( mismatched == 0 );
+        CHECK( last == static_cast< uint64_t >( samples ) );
+    }
+}
+
+
+int main()
+{
+    TestPublishLatest();
+    TestTriggerButtons();
+    TestCollect();
+    TestReadSinceLapped();
+    TestConcurrentConsumer();
+    return TestResult( "input_bus_test" );
+}
@@ -0,0 +1,224 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hmd_device_driver.h"
+#include "pose_kernel.h"
+#include "pose_prediction.h"
+#include "test_common.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs several simulated headsets side by side to show their input
+// and pose paths don't contend. Each instance owns what a device owns: an
+// InputBus fed by a GamepadPoller, HeadState and HotkeyState, and a pose
+// SeqLock. Its pose loop samples the pad and publishes a pose, its hotkey
+// loop walks the bus into the ramps, axis mappers and bind trackers, and a
+// GetPose() reader spins on the pose. The loops run flat out instead of at
+// frame rate, so any shared state shows up as a slower tick once instances
+// are added. The keyboard hook and XInput are Win32 only; a fake backend
+// stands in for the controller, tagging every instance's pad differently so
+// a sample crossing over would be caught.
+//
+//   instance_bench [ticks] [instances]    default 2000000, one per core pair, 2 to 8
+//-----------------------------------------------------------------------------
+namespace
+{
+    using BenchClock = std::chrono::steady_clock;
+
+    const double k_pi = 3.14159265358979323846;
+
+    // Right stick swings, the tag rides in the buttons
+    class SweepBackend : public IGamepadBackend
+    {
+    public:
+        explicit SweepBackend( uint16_t tag ) : tag_( tag ), tick_( 0 ) {}
+
+        bool GetState( uint32_t slot, GamepadState &state ) override
+        {
+            if ( slot != 0 )
+                return false;
+            tick_++;
+            state = {};
+            state.buttons = tag_;
+            state.thumb_rx = static_cast< int16_t >( 30000.0 * std::sin( tick_ * 1e-3 ) );
+            state.thumb_ry = static_cast< int16_t >( 20000.0 * std::cos( tick_ * 7e-4 ) );
+            return true;
+        }
+
+    private:
+        uint16_t tag_;
+        uint64_t tick_;
+    };
+
+    struct Instance
+    {
+        explicit Instance( uint16_t tag )
+            : tag( tag ), poller( std::make_unique< SweepBackend >( tag ) )
+        {
+            pose.Store( {} );
+        }
+
+        uint16_t tag;
+        InputBus bus;
+        GamepadPoller poller;
+        HeadState head;
+        HotkeyState hotkeys;
+        SeqLock< vr::DriverPose_t > pose;
+
+        std::atomic< bool > pose_done{ false };
+        double pose_ns = 0.0;
+        uint64_t crossed = 0;   // samples carrying another instance's tag
+        uint64_t collected = 0;
+        uint64_t reads = 0;
+        uint64_t torn = 0;      // poses read with a rotation that isn't unit length
+        double hotkey_sink = 0.0;
+        double read_sink = 0.0;
+    };
+
+    // The pose thread: sample, integrate, build and publish the pose
+    void PoseLoop( Instance &inst, long ticks )
+    {
+        const double tick_seconds = 0.008;
+        auto start = BenchClock::now();
+        for ( long tick = 0; tick < ticks; tick++ )
+        {
+            auto now = GamepadPoller::Clock::now();
+            GamepadState pad;
+            bool connected = inst.poller.Poll( now, pad );
+            auto timestamp = std::chrono::duration_cast< std::chrono::microseconds >( now.time_since_epoch() );
+            InputSample input = inst.bus.Publish( pad, connected, timestamp.count() );
+
+            float previous_pitch = inst.head.pitch;
+            inst.head.pitch = std::max( -90.0f, std::min( 90.0f, inst.head.pitch + input.pad.thumb_ry / 32767.0f * 0.1f ) );
+            double pitch_rate = ( inst.head.pitch - previous_pitch ) / tick_seconds;
+            double yaw_step = -input.pad.thumb_rx / 32767.0 * 0.1;
+            inst.head.yaw = WrapDegrees( inst.head.yaw + yaw_step );
+
+            double pitch = inst.head.pitch + PredictAngleOffset( PREDICT_DAMPED, pitch_rate, 0.011, 0.05 );
+            double yaw = WrapDegrees( inst.head.yaw + PredictAngleOffset( PREDICT_DAMPED, yaw_step / tick_seconds, 0.011, 0.05 ) );
+
+            vr::DriverPose_t pose = {};
+            ComputeHeadPose( pitch * k_pi / 180.0, yaw * k_pi / 180.0, 0.25, 1.7, pose.qRotation, pose.vecPosition );
+            pose.poseIsValid = true;
+            inst.pose.Store( pose );
+        }
+        inst.pose_ns = std::chrono::duration< double, std::nano >( BenchClock::now() - start ).count() / ticks;
+        inst.pose_done.store( true, std::memory_order_release );
+    }
+
+    // The hotkey thread: everything since the last pass into the hotkey state
+    void HotkeyLoop( Instance &inst )
+    {
+        AxisMapping mapping = { AXIS_RIGHT_STICK_Y, 0.1f, 1.0f, 0.05f, 0.001f };
+        uint64_t cursor = 0;
+        float depth = 0.5f;
+        while ( !inst.pose_done.load( std::memory_order_acquire ) )
+        {
+            inst.bus.ReadSince( cursor, [ & ]( const InputSample &sample ) {
+                inst.collected++;
+                if ( sample.pad.buttons != inst.tag )
+                    inst.crossed++;
+            } );
+            InputSample input = inst.bus.Latest();
+            auto now = AdjustRamp::Clock::now();
+            int direction = input.pad.thumb_rx > 16000 ? 1 : input.pad.thumb_rx < -16000 ? -1 : 0;
+            depth += inst.hotkeys.depth_ramp.Step( direction, now, 0.06f, 1.0f );
+            inst.hotkeys.toggle_top.Update( direction > 0, now );
+            float value;
+            if ( inst.hotkeys.depth_axis.Update( mapping, input, now, depth, value ) )
+                depth = value;
+            std::this_thread::yield();
+        }
+        inst.hotkey_sink = depth;
+    }
+
+    // A GetPose() caller
+    void ReadLoop( Instance &inst )
+    {
+        while ( !inst.pose_done.load( std::memory_order_acquire ) )
+        {
+            vr::DriverPose_t pose = inst.pose.Load();
+            const vr::HmdQuaternion_t &q = pose.qRotation;
+            double norm = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+            if ( pose.poseIsValid && std::fabs( norm - 1.0 ) > 1e-9 )
+                inst.torn++;
+            inst.reads++;
+            inst.read_sink += pose.vecPosition[ 0 ];
+        }
+    }
+
+    // Per-tick pose loop time, averaged over the instances
+    double Run( int count, long ticks, std::vector< std::unique_ptr< Instance > > &instances )
+    {
+        instances.clear();
+        for ( int i = 0; i < count; i++ )
+            instances.push_back( std::make_unique< Instance >( static_cast< uint16_t >( 0x0100 << ( i % 8 ) | i ) ) );
+
+        std::vector< std::thread > threads;
+        for ( auto &inst : instances )
+        {
+            threads.emplace_back( HotkeyLoop, std::ref( *inst ) );
+            threads.emplace_back( ReadLoop, std::ref( *inst ) );
+            threads.emplace_back( PoseLoop, std::ref( *inst ), ticks );
+        }
+        for ( auto &thread : threads )
+            thread.join();
+
+        double total = 0.0;
+        for ( auto &inst : instances )
+            total += inst->pose_ns;
+        return total / count;
+    }
+
+    void Check( const std::vector< std::unique_ptr< Instance > > &instances, long ticks )
+    {
+        for ( const auto &inst : instances )
+        {
+            CHECK( inst->crossed == 0 );
+            CHECK( inst->torn == 0 );
+            CHECK( inst->collected > 0 && inst->collected <= static_cast< uint64_t >( ticks ) );
+            CHECK( std::isfinite( inst->hotkey_sink ) && std::isfinite( inst->read_sink ) );
+        }
+    }
+}
+
+
+int main( int argc, char **argv )
+{
+    const long ticks = argc > 1 ? std::atol( argv[ 1 ] ) : 2000000;
+    unsigned cores = std::max( 2u, std::thread::hardware_concurrency() );
+    const int count = argc > 2 ? std::atoi( argv[ 2 ] ) : static_cast< int >( std::max( 2u, std::min( 8u, cores / 2 ) ) );
+
+    std::vector< std::unique_ptr< Instance > > instances;
+    double single_ns = Run( 1, ticks, instances );
+    Check( instances, ticks );
+    double parallel_ns = Run( count, ticks, instances );
+    Check( instances, ticks );
+
+    std::printf( "%ld ticks: 1 instance %.1f ns/tick, %d instances %.1f ns/tick (%.2fx)\n",
+        ticks, single_ns, count, parallel_ns, parallel_ns / single_ns );
+    return TestResult( "instance_bench" );
+}
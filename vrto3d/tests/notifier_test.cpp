@@ -0,0 +1,168 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "notifier.h"
+#include "test_common.h"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // Records the cues it plays; while held, Play() blocks like a beep would
+    struct Recording
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector< NotifyCue > played;
+        bool hold = false;
+        bool playing = false;
+    };
+
+    class RecordingSink : public INotifySink
+    {
+    public:
+        explicit RecordingSink( Recording &rec ) : rec_( rec ) {}
+
+        void Play( NotifyCue cue ) override
+        {
+            std::unique_lock< std::mutex > lock( rec_.mutex );
+            rec_.playing = true;
+            rec_.cv.notify_all();
+            rec_.cv.wait( lock, [ this ] { return !rec_.hold; } );
+            rec_.played.push_back( cue );
+            rec_.playing = false;
+            rec_.cv.notify_all();
+        }
+
+    private:
+        Recording &rec_;
+    };
+
+    // Wait until the sink has played count cues, false on timeout
+    bool WaitPlayed( Recording &rec, size_t count )
+    {
+        std::unique_lock< std::mutex > lock( rec.mutex );
+        return rec.cv.wait_for( lock, 2s, [ & ] { return rec.played.size() >= count; } );
+    }
+
+    void TestPlaysOnEverySink()
+    {
+        Recording a, b;
+        Notifier notifier;
+        notifier.AddSink( std::make_unique< RecordingSink >( a ) );
+        notifier.AddSink( std::make_unique< NullSink >() );
+        notifier.AddSink( std::make_unique< RecordingSink >( b ) );
+
+        // Nothing plays before Start()
+        notifier.Post( NOTIFY_SUCCESS );
+        notifier.Start();
+        notifier.Post( NOTIFY_SUCCESS );
+        CHECK( WaitPlayed( a, 1 ) );
+        CHECK( WaitPlayed( b, 1 ) );
+        notifier.Stop();
+
+        CHECK( a.played.size() == 1 && a.played[ 0 ] == NOTIFY_SUCCESS );
+        CHECK( b.played.size() == 1 );
+        Notifier::Stats stats = notifier.GetStats();
+        CHECK( stats.posted == 1 && stats.played == 1 && stats.coalesced == 0 );
+
+        // Or after Stop()
+        notifier.Post( NOTIFY_SUCCESS );
+        CHECK( notifier.GetStats().posted == 1 );
+    }
+
+    void TestPostDoesNotBlock()
+    {
+        Recording rec;
+        rec.hold = true;
+        Notifier notifier;
+        notifier.AddSink( std::make_unique< RecordingSink >( rec ) );
+        notifier.Start();
+
+        notifier.Post( NOTIFY_SUCCESS );
+        {
+            std::unique_lock< std::mutex > lock( rec.mutex );
+            CHECK( rec.cv.wait_for( lock, 2s, [ & ] { return rec.playing; } ) );
+        }
+
+        // The sink is stuck playing, posting must still return straight away
+        auto start = std::chrono::steady_clock::now();
+        for ( int i = 0; i < 1000; i++ )
+            notifier.Post( NOTIFY_SUCCESS );
+        CHECK( std::chrono::steady_clock::now() - start < 500ms );
+
+        {
+            std::lock_guard< std::mutex > lock( rec.mutex );
+            CHECK( rec.played.empty() );
+            rec.hold = false;
+        }
+        rec.cv.notify_all();
+        CHECK( WaitPlayed( rec, 2 ) );
+        notifier.Stop();
+    }
+
+    void TestOverflowCoalesces()
+    {
+        Recording rec;
+        rec.hold = true;
+        Notifier notifier;
+        notifier.AddSink( std::make_unique< RecordingSink >( rec ) );
+        notifier.Start();
+
+        notifier.Post( NOTIFY_SUCCESS );
+        {
+            std::unique_lock< std::mutex > lock( rec.mutex );
+            CHECK( rec.cv.wait_for( lock, 2s, [ & ] { return rec.playing; } ) );
+        }
+
+        // A burst while the first cue plays queues one more, the rest merge into it
+        for ( int i = 0; i < 100; i++ )
+            notifier.Post( NOTIFY_SUCCESS );
+        Notifier::Stats stats = notifier.GetStats();
+        CHECK( stats.posted == 101 );
+        CHECK( stats.coalesced == 99 );
+
+        {
+            std::lock_guard< std::mutex > lock( rec.mutex );
+            rec.hold = false;
+        }
+        rec.cv.notify_all();
+        CHECK( WaitPlayed( rec, 2 ) );
+
+        // Nothing else was queued behind the burst
+        std::this_thread::sleep_for( 50ms );
+        notifier.Stop();
+        CHECK( rec.played.size() == 2 );
+        CHECK( notifier.GetStats().played == 2 );
+    }
+}
+
+
+int main()
+{
+    TestPlaysOnEverySink();
+    TestPostDoesNotBlock();
+    TestOverflowCoalesces();
+    return TestResult( "notifier_test" );
+}
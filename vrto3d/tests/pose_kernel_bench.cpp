@@ -0,0 +1,118 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "pose_kernel.h"
+#include "test_common.h"
+
+// One translation unit per executable may include vrmath.h, it defines non-inline functions
+#include "vrmath.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Per-tick cost of the head pose, ComputeHeadPose against the
+// quaternion path it replaced: accumulate yaw into a quaternion and
+// renormalize it, recover the angle with acos, multiply in a pitch
+// quaternion, renormalize again and place the orbit from the full angles.
+// Both walk the same stick driven pitch & yaw sequence.
+//
+//   pose_kernel_bench [ticks]    default 10000000
+//-----------------------------------------------------------------------------
+namespace
+{
+    using BenchClock = std::chrono::steady_clock;
+
+    const double k_pi = 3.14159265358979323846;
+    const double k_radius = 0.25;
+    const double k_height = 1.7;
+
+    // Pitch sweeps back and forth, yaw keeps turning
+    double PitchAt( long tick )
+    {
+        return 0.6 * std::sin( tick * 1e-4 );
+    }
+
+    const float k_yaw_step = 0.002f;
+
+    double QuaternionPath( long ticks )
+    {
+        vr::HmdQuaternion_t yawQuat = { 1.0, 0.0, 0.0, 0.0 };
+        double sink = 0.0;
+        for ( long tick = 0; tick < ticks; tick++ )
+        {
+            vr::HmdQuaternion_t yawAdjust = QuaternionFromAxisAngle( 0.0f, 1.0f, 0.0f, k_yaw_step );
+            yawQuat = HmdQuaternion_Normalize( yawAdjust * yawQuat );
+
+            float pitchRadians = static_cast< float >( PitchAt( tick ) );
+            float yawRadians = 2.0f * std::acos( static_cast< float >( yawQuat.w ) );
+            vr::HmdQuaternion_t pitchQuat = QuaternionFromAxisAngle( 1.0f, 0.0f, 0.0f, pitchRadians );
+            vr::HmdQuaternion_t rotation = HmdQuaternion_Normalize( yawQuat * pitchQuat );
+
+            double position[ 3 ];
+            position[ 0 ] = k_radius * cos( pitchRadians ) * sin( yawRadians ) - k_radius * sin( yawRadians );
+            position[ 1 ] = k_height - k_radius * sin( pitchRadians );
+            position[ 2 ] = k_radius * cos( pitchRadians ) * cos( yawRadians ) - k_radius * cos( yawRadians );
+
+            sink += rotation.w + rotation.y + position[ 0 ] + position[ 2 ];
+        }
+        return sink;
+    }
+
+    double ClosedForm( long ticks )
+    {
+        double yaw = 0.0;
+        double sink = 0.0;
+        for ( long tick = 0; tick < ticks; tick++ )
+        {
+            yaw = WrapDegrees( yaw + k_yaw_step * 180.0 / k_pi );
+
+            vr::HmdQuaternion_t rotation;
+            double position[ 3 ];
+            ComputeHeadPose( PitchAt( tick ), yaw * k_pi / 180.0, k_radius, k_height, rotation, position );
+
+            sink += rotation.w + rotation.y + position[ 0 ] + position[ 2 ];
+        }
+        return sink;
+    }
+
+    template < typename Fn >
+    double Time( Fn &&fn, long ticks, double &sink )
+    {
+        auto start = BenchClock::now();
+        sink = fn( ticks );
+        return std::chrono::duration< double, std::nano >( BenchClock::now() - start ).count() / ticks;
+    }
+}
+
+
+int main( int argc, char **argv )
+{
+    const long ticks = argc > 1 ? std::atol( argv[ 1 ] ) : 10000000;
+
+    double quaternion_sink, closed_sink;
+    double quaternion_ns = Time( QuaternionPath, ticks, quaternion_sink );
+    double closed_ns = Time( ClosedForm, ticks, closed_sink );
+
+    // Keeps both loops from being optimized away
+    CHECK( std::isfinite( quaternion_sink ) && std::isfinite( closed_sink ) );
+
+    std::printf( "%ld ticks: quaternion path %.1f ns/tick, ComputeHeadPose %.1f ns/tick\n", ticks, quaternion_ns, closed_ns );
+    return TestResult( "pose_kernel_bench" );
+}
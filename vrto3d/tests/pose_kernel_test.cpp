@@ -0,0 +1,126 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+
+#include "pose_kernel.h"
+#include "test_common.h"
+
+// One translation unit per executable may include vrmath.h, it defines non-inline functions
+#include "vrmath.h"
+
+
+namespace
+{
+    const double k_pi = 3.14159265358979323846;
+
+    double Radians( double degrees )
+    {
+        return degrees * k_pi / 180.0;
+    }
+
+    //-------------------------------------------------------------------------
+    // Purpose: The Euler path ComputeHeadPose replaced: a yaw quaternion times
+    // a pitch quaternion, renormalized, and the orbit position from the full
+    // angles. The original recovered yaw from the accumulated quaternion with
+    // 2 * acos(w), which drops its sign; the reference takes the angle as is.
+    //-------------------------------------------------------------------------
+    void EulerHeadPose( double pitch, double yaw, double radius, double height, vr::HmdQuaternion_t &rotation, double position[ 3 ] )
+    {
+        vr::HmdQuaternion_t yawQuat = QuaternionFromAxisAngle( 0.0f, 1.0f, 0.0f, static_cast< float >( yaw ) );
+        vr::HmdQuaternion_t pitchQuat = QuaternionFromAxisAngle( 1.0f, 0.0f, 0.0f, static_cast< float >( pitch ) );
+        rotation = HmdQuaternion_Normalize( yawQuat * pitchQuat );
+
+        position[ 0 ] = radius * cos( pitch ) * sin( yaw ) - radius * sin( yaw );
+        position[ 1 ] = height - radius * sin( pitch );
+        position[ 2 ] = radius * cos( pitch ) * cos( yaw ) - radius * cos( yaw );
+    }
+
+    void TestMatchesEulerPath()
+    {
+        const double radius = 0.25;
+        const double height = 1.7;
+        for ( int pitch_deg = -89; pitch_deg <= 89; pitch_deg += 7 )
+        {
+            for ( int yaw_deg = -180; yaw_deg <= 180; yaw_deg += 5 )
+            {
+                double pitch = Radians( pitch_deg );
+                double yaw = Radians( yaw_deg );
+
+                vr::HmdQuaternion_t expected, actual;
+                double expected_pos[ 3 ], actual_pos[ 3 ];
+                EulerHeadPose( pitch, yaw, radius, height, expected, expected_pos );
+                ComputeHeadPose( pitch, yaw, radius, height, actual, actual_pos );
+
+                // The reference goes through floats, hence the tolerance
+                CHECK_NEAR( actual.w, expected.w, 1e-6 );
+                CHECK_NEAR( actual.x, expected.x, 1e-6 );
+                CHECK_NEAR( actual.y, expected.y, 1e-6 );
+                CHECK_NEAR( actual.z, expected.z, 1e-6 );
+                for ( int i = 0; i < 3; i++ )
+                    CHECK_NEAR( actual_pos[ i ], expected_pos[ i ], 1e-6 );
+
+                // Unit length without renormalizing
+                double norm = actual.w * actual.w + actual.x * actual.x + actual.y * actual.y + actual.z * actual.z;
+                CHECK_NEAR( norm, 1.0, 1e-12 );
+            }
+        }
+    }
+
+    void TestLevelPitchStaysOnAxis()
+    {
+        // No orbit offset at all when level, whatever the yaw
+        for ( int yaw_deg = -180; yaw_deg <= 180; yaw_deg += 15 )
+        {
+            vr::HmdQuaternion_t rotation;
+            double position[ 3 ];
+            ComputeHeadPose( 0.0, Radians( yaw_deg ), 0.25, 1.5, rotation, position );
+            CHECK( position[ 0 ] == 0.0 );
+            CHECK( position[ 1 ] == 1.5 );
+            CHECK( position[ 2 ] == 0.0 );
+        }
+
+        // Tiny pitches keep their precision instead of cancelling to zero
+        vr::HmdQuaternion_t rotation;
+        double position[ 3 ];
+        ComputeHeadPose( 1e-6, 0.0, 1.0, 0.0, rotation, position );
+        CHECK_NEAR( position[ 2 ], -0.5e-12, 1e-20 );
+    }
+
+    void TestWrapDegrees()
+    {
+        CHECK_NEAR( WrapDegrees( 0.0 ), 0.0, 1e-12 );
+        CHECK_NEAR( WrapDegrees( 190.0 ), -170.0, 1e-12 );
+        CHECK_NEAR( WrapDegrees( -190.0 ), 170.0, 1e-12 );
+        CHECK_NEAR( WrapDegrees( 720.0 + 45.0 ), 45.0, 1e-12 );
+        CHECK( std::fabs( WrapDegrees( 180.0 ) ) == 180.0 );
+
+        // Accumulating small steps for a long time doesn't drift
+        double yaw = 0.0;
+        for ( int i = 0; i < 360000; i++ )
+            yaw = WrapDegrees( yaw + 0.1 );
+        CHECK_NEAR( yaw, 0.0, 1e-6 );
+    }
+}
+
+
+int main()
+{
+    TestMatchesEulerPath();
+    TestLevelPitchStaysOnAxis();
+    TestWrapDegrees();
+    return TestResult( "pose_kernel_test" );
+}
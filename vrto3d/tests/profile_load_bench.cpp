@@ -0,0 +1,149 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "config_fields.h"
+#include "json_manager.h"
+#include "test_common.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Load time of many game profiles with and without their compiled
+// sidecars. JsonManager itself is Win32 only, so this repeats its load path
+// with standard file I/O: stat the JSON, then either parse, compile, write
+// the sidecar and bind (cold), or read the sidecar, validate and bind (warm).
+//
+//   profile_load_bench [profiles]    default 500
+//-----------------------------------------------------------------------------
+namespace
+{
+    namespace fs = std::filesystem;
+    using BenchClock = std::chrono::steady_clock;
+
+    double Ms( BenchClock::time_point since )
+    {
+        return std::chrono::duration< double, std::milli >( BenchClock::now() - since ).count();
+    }
+
+    std::vector< uint8_t > ReadBytes( const fs::path &path )
+    {
+        std::ifstream file( path, std::ios::binary );
+        return std::vector< uint8_t >( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+    }
+
+    void WriteBytes( const fs::path &path, const void *data, size_t size )
+    {
+        std::ofstream file( path, std::ios::binary | std::ios::trunc );
+        file.write( static_cast< const char * >( data ), static_cast< std::streamsize >( size ) );
+    }
+
+    // Size and a write time stand-in, the sidecar key JsonManager gets from GetFileAttributesEx
+    void Stat( const fs::path &path, uint64_t &size, uint64_t &write_time )
+    {
+        size = fs::file_size( path );
+        write_time = static_cast< uint64_t >( fs::last_write_time( path ).time_since_epoch().count() );
+    }
+
+    // A typical saved profile with three user settings
+    std::string MakeProfile( int i, const StereoDisplayDriverConfiguration &defaults )
+    {
+        StereoDisplayDriverConfiguration config = defaults;
+        config.depth = 0.001f * i;
+        config.convergence = 0.02f + 0.0001f * i;
+        config.num_user_settings = 3;
+        config.user_load_str = { "VK_NUMPAD1", "XINPUT_GAMEPAD_GUIDE", "XINPUT_GAMEPAD_LEFT_TRIGGER" };
+        config.user_store_str = { "VK_NUMPAD4", "VK_NUMPAD5", "VK_CONTROL+VK_NUMPAD6" };
+        config.user_type_str = { "switch", "toggle", "hold" };
+        config.user_key_type = { 1, 2, 3 };
+        config.user_depth = { 0.5f, 0.1f, 0.25f };
+        config.user_convergence = { 0.02f, 0.02f, 0.02f };
+        return ProfileToJson( config ).dump( 4 );
+    }
+}
+
+
+int main( int argc, char **argv )
+{
+    const int profiles = argc > 1 ? std::atoi( argv[ 1 ] ) : 500;
+    const fs::path dir = fs::temp_directory_path() / "vrto3d_profile_load_bench";
+    fs::remove_all( dir );
+    fs::create_directories( dir );
+
+    StereoDisplayDriverConfiguration defaults{};
+    BindParams( CompiledProfile(), defaults, DEF_CFG );
+    BindProfile( CompiledProfile(), defaults, DEF_CFG, nullptr );
+
+    std::vector< fs::path > json_paths;
+    for ( int i = 0; i < profiles; i++ )
+    {
+        json_paths.push_back( dir / ( "game" + std::to_string( i ) + "_config.json" ) );
+        std::string text = MakeProfile( i, defaults );
+        WriteBytes( json_paths.back(), text.data(), text.size() );
+    }
+
+    // Cold: no sidecars yet, every profile is parsed, compiled and written out
+    StereoDisplayDriverConfiguration cold_config = defaults;
+    auto start = BenchClock::now();
+    for ( const auto &path : json_paths )
+    {
+        uint64_t size, write_time;
+        Stat( path, size, write_time );
+        std::vector< uint8_t > text = ReadBytes( path );
+        CompiledProfile profile = CompileProfile( nlohmann::json::parse( text ), size, write_time, path.filename().string() );
+        WriteBytes( fs::path( path ).concat( ".bin" ), profile.data(), profile.size() );
+        BindProfile( profile, cold_config, path.filename().string(), &defaults );
+    }
+    double cold_ms = Ms( start );
+
+    // Warm: a fresh manager with the sidecars on disk
+    StereoDisplayDriverConfiguration warm_config = defaults;
+    int rejected = 0;
+    start = BenchClock::now();
+    for ( const auto &path : json_paths )
+    {
+        uint64_t size, write_time;
+        Stat( path, size, write_time );
+        CompiledProfile profile = ReadBytes( fs::path( path ).concat( ".bin" ) );
+        if ( !ValidateProfile( profile.data(), profile.size(), size, write_time ) )
+        {
+            rejected++;
+            continue;
+        }
+        BindProfile( profile, warm_config, path.filename().string(), &defaults );
+    }
+    double warm_ms = Ms( start );
+
+    // Both paths end on the same profile
+    CHECK( rejected == 0 );
+    CHECK( ProfileToJson( warm_config ) == ProfileToJson( cold_config ) );
+
+    std::printf( "%d profiles: cold (stat, parse, compile, write sidecar, bind) %.1f ms, warm (stat, read sidecar, validate, bind) %.1f ms\n",
+        profiles, cold_ms, warm_ms );
+
+    fs::remove_all( dir );
+    return TestResult( "profile_load_bench" );
+}
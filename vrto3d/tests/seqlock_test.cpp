@@ -0,0 +1,171 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "pose_kernel.h"
+#include "seqlock.h"
+#include "test_common.h"
+
+
+namespace
+{
+    // Wider than one word, with an odd tail, so a torn copy shows up as
+    // fields that disagree
+    struct Sample
+    {
+        uint64_t a;
+        uint64_t b;
+        double c;
+        uint32_t d;
+    };
+
+    void TestStoreLoad()
+    {
+        SeqLock< Sample > slot;
+        Sample empty = slot.Load();
+        CHECK( empty.a == 0 && empty.b == 0 && empty.c == 0.0 && empty.d == 0 );
+        CHECK( slot.Version() == 0 );
+
+        slot.Store( Sample{ 1, 2, 3.5, 4 } );
+        Sample value = slot.Load();
+        CHECK( value.a == 1 && value.b == 2 && value.c == 3.5 && value.d == 4 );
+        CHECK( slot.Version() == 1 );
+
+        slot.Store( Sample{ 5, 6, 7.5, 8 } );
+        CHECK( slot.Load().d == 8 );
+        CHECK( slot.Version() == 2 );
+
+        SeqLock< float > seeded( 0.25f );
+        CHECK( seeded.Load() == 0.25f );
+        CHECK( seeded.Version() == 1 );
+    }
+
+    void TestConcurrentReaders()
+    {
+        const uint64_t stores = 200000;
+        SeqLock< Sample > slot;
+        std::atomic< bool > done( false );
+        std::atomic< int > torn( 0 );
+        std::atomic< int > backwards( 0 );
+
+        std::vector< std::thread > readers;
+        for ( int r = 0; r < 3; r++ )
+        {
+            readers.emplace_back( [ & ]()
+            {
+                uint64_t last = 0;
+                while ( !done.load( std::memory_order_acquire ) )
+                {
+                    Sample value = slot.Load();
+                    if ( value.b != value.a || value.c != static_cast< double >( value.a ) || value.d != static_cast< uint32_t >( value.a ) )
+                        torn++;
+                    if ( value.a < last )
+                        backwards++;
+                    last = value.a;
+                }
+            } );
+        }
+
+        for ( uint64_t i = 1; i <= stores; i++ )
+            slot.Store( Sample{ i, i, static_cast< double >( i ), static_cast< uint32_t >( i ) } );
+        done.store( true, std::memory_order_release );
+        for ( auto &reader : readers )
+            reader.join();
+
+        CHECK( torn.load() == 0 );
+        CHECK( backwards.load() == 0 );
+        CHECK( slot.Version() == stores );
+        CHECK( slot.Load().a == stores );
+    }
+
+    // The pose the pose thread would publish on a given tick, tagged with it
+    vr::DriverPose_t PoseAt( uint64_t tick )
+    {
+        vr::DriverPose_t pose = {};
+        double pitch = 0.5 * std::sin( tick * 1e-3 );
+        double yaw = WrapDegrees( tick * 0.37 ) * 3.14159265358979323846 / 180.0;
+        pose.qWorldFromDriverRotation = { 1.0, 0.0, 0.0, 0.0 };
+        pose.qDriverFromHeadRotation = { 1.0, 0.0, 0.0, 0.0 };
+        ComputeHeadPose( pitch, yaw, 0.25, 1.7, pose.qRotation, pose.vecPosition );
+        pose.vecAngularVelocity[ 0 ] = pitch;
+        pose.vecAngularVelocity[ 1 ] = yaw;
+        pose.poseTimeOffset = static_cast< double >( tick );
+        pose.poseIsValid = true;
+        pose.deviceIsConnected = true;
+        pose.result = vr::TrackingResult_Running_OK;
+        return pose;
+    }
+
+    // curr_pose_ as the driver uses it: PoseUpdateThread stores a DriverPose_t
+    // every tick while vrserver threads call GetPose()
+    void TestConcurrentGetPose()
+    {
+        const uint64_t ticks = 100000;
+        SeqLock< vr::DriverPose_t > curr_pose( PoseAt( 0 ) );
+        std::atomic< bool > done( false );
+        std::atomic< int > torn( 0 );
+        std::atomic< int > backwards( 0 );
+        std::atomic< uint64_t > reads( 0 );
+
+        std::vector< std::thread > readers;
+        for ( int r = 0; r < 3; r++ )
+        {
+            readers.emplace_back( [ & ]()
+            {
+                uint64_t last = 0;
+                while ( !done.load( std::memory_order_acquire ) )
+                {
+                    // Every field has to be the one published for the tagged tick
+                    vr::DriverPose_t pose = curr_pose.Load();
+                    uint64_t tick = static_cast< uint64_t >( pose.poseTimeOffset );
+                    vr::DriverPose_t expected = PoseAt( tick );
+                    if ( std::memcmp( &pose, &expected, sizeof( pose ) ) != 0 )
+                        torn++;
+                    if ( tick < last )
+                        backwards++;
+                    last = tick;
+                    reads++;
+                }
+            } );
+        }
+
+        for ( uint64_t tick = 1; tick <= ticks; tick++ )
+            curr_pose.Store( PoseAt( tick ) );
+        done.store( true, std::memory_order_release );
+        for ( auto &reader : readers )
+            reader.join();
+
+        CHECK( torn.load() == 0 );
+        CHECK( backwards.load() == 0 );
+        CHECK( reads.load() > 0 );
+        CHECK( curr_pose.Load().poseTimeOffset == static_cast< double >( ticks ) );
+    }
+}
+
+
+int main()
+{
+    TestStoreLoad();
+    TestConcurrentReaders();
+    TestConcurrentGetPose();
+    return TestResult( "seqlock_test" );
+}
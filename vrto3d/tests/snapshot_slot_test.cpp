@@ -0,0 +1,119 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "snapshot_slot.h"
+#include "test_common.h"
+
+
+namespace
+{
+    std::atomic< int > g_alive( 0 );
+
+    // Snapshot that knows whether it is still alive and whether it is whole
+    struct Snapshot
+    {
+        explicit Snapshot( uint64_t n ) : id( n ), values( 16, n ) { g_alive++; }
+        ~Snapshot() { id = ~0ull; g_alive--; }
+
+        bool Whole() const
+        {
+            for ( uint64_t value : values )
+                if ( value != id )
+                    return false;
+            return true;
+        }
+
+        uint64_t id;
+        std::vector< uint64_t > values;
+    };
+
+    void TestLoadStore()
+    {
+        {
+            SnapshotSlot< Snapshot > slot( std::make_shared< const Snapshot >( 0 ) );
+            CHECK( slot.Load()->id == 0 );
+            CHECK( slot.Version() == 0 );
+
+            auto held = slot.Load();
+            slot.Store( std::make_shared< const Snapshot >( 1 ) );
+            slot.Store( std::make_shared< const Snapshot >( 2 ) );
+            CHECK( slot.Load()->id == 2 );
+            CHECK( slot.Version() == 2 );
+
+            // A reader's copy outlives the slot it came from
+            CHECK( held->id == 0 && held->Whole() );
+            CHECK( g_alive.load() == 3 );
+            held.reset();
+            // Only the live snapshot and the one before it are kept
+            CHECK( g_alive.load() == 2 );
+        }
+        CHECK( g_alive.load() == 0 );
+    }
+
+    void TestConcurrentReaders()
+    {
+        const uint64_t stores = 50000;
+        {
+            SnapshotSlot< Snapshot > slot( std::make_shared< const Snapshot >( 0 ) );
+            std::atomic< bool > done( false );
+            std::atomic< int > broken( 0 );
+            std::atomic< int > backwards( 0 );
+
+            std::vector< std::thread > readers;
+            for ( int r = 0; r < 4; r++ )
+            {
+                readers.emplace_back( [ & ]()
+                {
+                    uint64_t last = 0;
+                    while ( !done.load( std::memory_order_acquire ) )
+                    {
+                        auto snapshot = slot.Load();
+                        if ( !snapshot->Whole() )
+                            broken++;
+                        if ( snapshot->id < last )
+                            backwards++;
+                        last = snapshot->id;
+                    }
+                } );
+            }
+
+            for ( uint64_t i = 1; i <= stores; i++ )
+                slot.Store( std::make_shared< const Snapshot >( i ) );
+            done.store( true, std::memory_order_release );
+            for ( auto &reader : readers )
+                reader.join();
+
+            CHECK( broken.load() == 0 );
+            CHECK( backwards.load() == 0 );
+            CHECK( slot.Load()->id == stores );
+        }
+        CHECK( g_alive.load() == 0 );
+    }
+}
+
+
+int main()
+{
+    TestLoadStore();
+    TestConcurrentReaders();
+    return TestResult( "snapshot_slot_test" );
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+
+//-----------------------------------------------------------------------------
+// Purpose: Minimal checks for the unit tests. A failed check prints where it
+// failed and is counted; each test's main() returns TestResult().
+//-----------------------------------------------------------------------------
+inline int &TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK( cond ) \
+    do { \
+        if ( !( cond ) ) \
+        { \
+            std::printf( "%s:%d: CHECK( %s ) failed\n", __FILE__, __LINE__, #cond ); \
+            TestFailures()++; \
+        } \
+    } while ( 0 )
+
+#define CHECK_NEAR( a, b, eps ) \
+    do { \
+        const double check_a = static_cast< double >( a ); \
+        const double check_b = static_cast< double >( b ); \
+        if ( !( std::fabs( check_a - check_b ) <= ( eps ) ) ) \
+        { \
+            std::printf( "%s:%d: CHECK_NEAR( %s, %s ) failed: %.9g vs %.9g\n", __FILE__, __LINE__, #a, #b, check_a, check_b ); \
+            TestFailures()++; \
+        } \
+    } while ( 0 )
+
+inline int TestResult( const char *suite )
+{
+    if ( TestFailures() != 0 )
+    {
+        std::printf( "%s: %d check(s) failed\n", suite, TestFailures() );
+        return 1;
+    }
+    std::printf( "%s: all checks passed\n", suite );
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * This file is part of VRto3D.
+ *
+ * VRto3D is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * VRto3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with VRto3D. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdarg>
+#include <cstdio>
+
+#include "driverlog.h"
+
+
+//-----------------------------------------------------------------------------
+// Purpose: The tests run without vrserver, so the driver log goes to stdout
+//-----------------------------------------------------------------------------
+void DriverLog( const char *pchFormat, ... )
+{
+    va_list args;
+    va_start( args, pchFormat );
+    std::vprintf( pchFormat, args );
+    va_end( args );
+}
+
+void DebugDriverLog( const char *pchFormat, ... )
+{
+    va_list args;
+    va_start( args, pchFormat );
+    std::vprintf( pchFormat, args );
+    va_end( args );
+}